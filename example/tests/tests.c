@@ -11,11 +11,11 @@ void test_sum(YacuTestRun* testRun)
 }
 
 YacuTest calculatorTests[] = {
-    {"SumTest", &test_sum},
+    YACU_TEST("SumTest", &test_sum),
     END_OF_TESTS};
 
 YacuSuite suites[] = {
-    {"CalculatorSuite", calculatorTests},
+    YACU_SUITE("CalculatorSuite", calculatorTests),
     END_OF_SUITES};
 
 int main(int argc, char const *argv[])
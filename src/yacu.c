@@ -23,11 +23,44 @@ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
 OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 ****************************************************************************/
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
 #include <yacu.h>
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <limits.h>
+#include <time.h>
+#include <math.h>
+
+#ifdef FORK_AVAILABLE
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <dirent.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#endif
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define YACU_X86_SIMD
+#include <immintrin.h>
+#endif
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
 
 static bool end_of_suites(const YacuSuite suite)
 {
@@ -51,305 +84,4713 @@ YacuOptions yacu_default_options()
         .testName = NULL,
         .jUnitPath = NULL,
         .stdoutReport = true,
-        .customReport = NULL};
+        .customReport = NULL,
+        .jobs = 1,
+        .isolated = false,
+        .globalSetup = NULL,
+        .globalTeardown = NULL,
+        .slowest = 0,
+        .benchmarkTime = 0.01,
+        .benchmarkWarmups = 1,
+        .benchmarkRepetitions = 10,
+        .regressionThreshold = 0.05};
     return options;
 }
 
-static void vbuffer_append(char *buffer, size_t bufferMaxSize, const char *format, va_list args)
+#ifdef FORK_AVAILABLE
+#define YACU_THREAD_LOCAL __thread
+#else
+#define YACU_THREAD_LOCAL
+#endif
+
+// Shared with the optional yacualloc tracker, which sets the flag when it
+// is linked and counts into the stats of the test running on its thread.
+bool yacuAllocTracking = false;
+YACU_THREAD_LOCAL YacuAllocStats *yacuActiveAllocs = NULL;
+
+bool yacu_alloc_tracking()
 {
-    size_t bufferLength = strlen(buffer);
-    vsnprintf(buffer + bufferLength, bufferMaxSize - bufferLength, format, args);
+    return yacuAllocTracking;
 }
 
-static void buffer_append(char *buffer, size_t bufferMaxSize, const char *format, ...)
+static double yacu_now()
 {
-    va_list args;
-    va_start(args, format);
-    vbuffer_append(buffer, bufferMaxSize, format, args);
-    va_end(args);
+    struct timespec now;
+#ifdef FORK_AVAILABLE
+    clock_gettime(CLOCK_MONOTONIC, &now);
+#else
+    timespec_get(&now, TIME_UTC);
+#endif
+    return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
 }
 
-static void process_test_or_suite_arg(int i, int argc, char const *argv[], YacuOptions *options, bool withTest)
+#ifdef FORK_AVAILABLE
+static void usage_from_rusage(const struct rusage *rusage, YacuResourceUsage *usage)
 {
-    if (argc <= i + (withTest ? 2 : 1))
+#ifdef __APPLE__
+    usage->maxRssKb = rusage->ru_maxrss / 1024;
+#else
+    usage->maxRssKb = rusage->ru_maxrss;
+#endif
+    usage->minorFaults = rusage->ru_minflt;
+    usage->majorFaults = rusage->ru_majflt;
+    usage->voluntarySwitches = rusage->ru_nvcsw;
+    usage->involuntarySwitches = rusage->ru_nivcsw;
+}
+#endif
+
+static void yacu_usage(double *userTime, double *systemTime, YacuResourceUsage *usage)
+{
+#ifdef FORK_AVAILABLE
+    struct rusage rusage;
+#ifdef RUSAGE_THREAD
+    getrusage(RUSAGE_THREAD, &rusage);
+#else
+    getrusage(RUSAGE_SELF, &rusage);
+#endif
+    *userTime = (double)rusage.ru_utime.tv_sec + (double)rusage.ru_utime.tv_usec * 1e-6;
+    *systemTime = (double)rusage.ru_stime.tv_sec + (double)rusage.ru_stime.tv_usec * 1e-6;
+    usage_from_rusage(&rusage, usage);
+#else
+    *userTime = (double)clock() / CLOCKS_PER_SEC;
+    *systemTime = 0.0;
+    memset(usage, 0, sizeof(YacuResourceUsage));
+#endif
+}
+
+static void start_timing(YacuTestRun *testRun)
+{
+    yacu_usage(&testRun->userTime, &testRun->systemTime, &testRun->usage);
+    testRun->startTime = yacu_now();
+}
+
+static void stop_timing(YacuTestRun *testRun)
+{
+    testRun->duration = yacu_now() - testRun->startTime;
+    double userTime, systemTime;
+    YacuResourceUsage usage;
+    yacu_usage(&userTime, &systemTime, &usage);
+    testRun->userTime = userTime - testRun->userTime;
+    testRun->systemTime = systemTime - testRun->systemTime;
+    testRun->usage.maxRssKb = usage.maxRssKb;
+    testRun->usage.minorFaults = usage.minorFaults - testRun->usage.minorFaults;
+    testRun->usage.majorFaults = usage.majorFaults - testRun->usage.majorFaults;
+    testRun->usage.voluntarySwitches = usage.voluntarySwitches - testRun->usage.voluntarySwitches;
+    testRun->usage.involuntarySwitches = usage.involuntarySwitches - testRun->usage.involuntarySwitches;
+}
+
+// Messages live in an arena that grows on demand and is reset in bulk between
+// tests, so passing tests cost nothing and long diagnostics are not truncated.
+typedef struct YacuMessageArena
+{
+    char *data;
+    size_t length;
+    size_t capacity;
+} YacuMessageArena;
+
+static void arena_reserve(YacuMessageArena *arena, size_t extra)
+{
+    if (arena->length + extra < arena->capacity)
     {
-        exit(WRONG_ARGS);
+        return;
     }
-    options->suiteName = argv[i + 1];
-    if (withTest)
+    size_t capacity = arena->capacity == 0 ? 256 : arena->capacity;
+    while (arena->length + extra >= capacity)
     {
-        options->testName = argv[i + 2];
+        capacity *= 2;
+    }
+    arena->data = realloc(arena->data, capacity);
+    if (arena->data == NULL)
+    {
+        exit(FATAL);
     }
+    arena->capacity = capacity;
 }
 
-void yacu_apply_cmd_args(YacuOptions *options, int argc, char const *argv[])
+static void arena_vappend(YacuMessageArena *arena, const char *format, va_list args)
 {
-    for (int i = 1; i < argc; i++)
+    va_list retryArgs;
+    va_copy(retryArgs, args);
+    arena_reserve(arena, 1);
+    int length = vsnprintf(arena->data + arena->length, arena->capacity - arena->length, format, args);
+    if (length > 0 && arena->length + (size_t)length >= arena->capacity)
     {
-        if (strcmp(argv[i], "--test") == 0)
-        {
-            process_test_or_suite_arg(i, argc, argv, options, true);
-            i = i + 2;
-        }
-        else if (strcmp(argv[i], "--suite") == 0)
-        {
-            process_test_or_suite_arg(i, argc, argv, options, false);
-            i++;
-        }
-        else if (strcmp(argv[i], "--junit") == 0)
-        {
-            if (argc <= i + 1)
-            {
-                exit(WRONG_ARGS);
-            }
-            options->jUnitPath = argv[i + 1];
-            i++;
-        }
-        else
-        {
-            exit(WRONG_ARGS);
-        }
+        arena_reserve(arena, (size_t)length + 1);
+        vsnprintf(arena->data + arena->length, arena->capacity - arena->length, format, retryArgs);
     }
+    arena->length += length > 0 ? (size_t)length : 0;
+    va_end(retryArgs);
 }
 
-typedef struct JUnitReport
+static size_t arena_store(YacuMessageArena *arena, const char *format, ...)
 {
-    char jUnitBuffer[YACU_TEST_RUN_MESSAGE_MAX_SIZE];
-    const char *jUnitPath;
-} JUnitReport;
+    size_t offset = arena->length;
+    va_list args;
+    va_start(args, format);
+    arena_vappend(arena, format, args);
+    va_end(args);
+    arena->length++;
+    return offset;
+}
 
-#define UNUSED(x) (void)(x)
+static void arena_reset(YacuMessageArena *arena)
+{
+    arena->length = 0;
+}
 
-static void junit_report_action(YacuReportState state, YacuReportEvent reportEvent, const YacuSuite *suite, const YacuTestRun *testRun)
+static void arena_free(YacuMessageArena *arena)
 {
-    JUnitReport *current = (JUnitReport *)state;
-    switch (reportEvent)
+    free(arena->data);
+    arena->data = NULL;
+    arena->length = 0;
+    arena->capacity = 0;
+}
+
+static void test_run_message_vappend(YacuTestRun *testRun, const char *format, va_list args)
+{
+    if (testRun->arena == NULL)
     {
-    case SUITE_STARTED:
-        buffer_append(current->jUnitBuffer, YACU_TEST_RUN_MESSAGE_MAX_SIZE,
-                      "  <testsuite package=\"\" id=\"0\" name=\"%s\"", suite->name);
-        buffer_append(current->jUnitBuffer, YACU_TEST_RUN_MESSAGE_MAX_SIZE,
-                      " timestamp=\"1900-12-12T%11:11:11\"");
-        buffer_append(current->jUnitBuffer, YACU_TEST_RUN_MESSAGE_MAX_SIZE,
-                      " hostname=\"-\" tests=\"4\" failures=\"2\" errors=\"1\" time=\"3\">\n");
-        buffer_append(current->jUnitBuffer, YACU_TEST_RUN_MESSAGE_MAX_SIZE,
-                      "    <properties/>\n");
-        break;
-    case TEST_RUN_STARTED:
-        buffer_append(current->jUnitBuffer, YACU_TEST_RUN_MESSAGE_MAX_SIZE,
-                      "    <testcase classname=\"\" name=\"%s\" time=\"0.0\">\n",
-                      testRun->test->name);
-        break;
-    case TEST_RUN_FINISHED:
-        buffer_append(current->jUnitBuffer, YACU_TEST_RUN_MESSAGE_MAX_SIZE,
-                      "    </testcase>\n");
-        break;
-    case SUITE_FINISHED:
-        buffer_append(current->jUnitBuffer, YACU_TEST_RUN_MESSAGE_MAX_SIZE,
-                      "    <system-out/>\n"
-                      "    <system-err/>\n"
-                      "  </testsuite>\n");
-        break;
-    case TESTING_FINISHED:
-        buffer_append(current->jUnitBuffer, YACU_TEST_RUN_MESSAGE_MAX_SIZE,
-                      "</testsuites>\n");
-        if (current->jUnitPath != NULL)
+        testRun->arena = calloc(1, sizeof(YacuMessageArena));
+        if (testRun->arena == NULL)
         {
-            FILE *jUnitFile = fopen(current->jUnitPath, "w");
-            if (jUnitFile == NULL)
-            {
-                exit(FILE_FAIL);
-            }
-            fprintf(jUnitFile, "%s", current->jUnitBuffer);
-            fflush(jUnitFile);
-            fclose(jUnitFile);
+            exit(FATAL);
         }
-        break;
-    default:
-        return;
     }
+    arena_vappend(testRun->arena, format, args);
+    testRun->message = testRun->arena->data;
+    testRun->messageLength = testRun->arena->length;
 }
 
-static void stdout_on_test_finished(const YacuTestRun *testRun)
+void test_run_message_append(YacuTestRun *testRun, const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    test_run_message_vappend(testRun, format, args);
+    va_end(args);
+}
+
+typedef struct NameSlot
+{
+    const char *name;
+    size_t value;
+} NameSlot;
+
+typedef struct NameMap
+{
+    NameSlot *slots;
+    size_t capacity;
+    size_t count;
+} NameMap;
+
+static uint64_t name_hash(const char *name)
 {
-    switch (testRun->result)
+    uint64_t hash = 14695981039346656037ULL;
+    for (const unsigned char *it = (const unsigned char *)name; *it != '\0'; it++)
     {
-    case OK:
-        printf("    OK\n");
-        break;
-    case TEST_ERROR:
-        printf("    ERROR\n");
-        break;
-    case TEST_FAILURE:
-        printf("    FAILURE\n");
-        break;
-    case WRONG_ARGS:
-        printf("    WRONG_ARGS\n");
-        break;
-    case FORK_FAIL:
-        printf("    FORK_FAIL\n");
-        break;
-    case FILE_FAIL:
-        printf("    FILE_FAIL\n");
-        break;
-    case FATAL:
-        printf("    FATAL\n");
-        break;
+        hash = (hash ^ *it) * 1099511628211ULL;
     }
-    if (strlen(testRun->message) > 0)
+    return hash;
+}
+
+static NameSlot *name_map_slot(const NameMap *map, const char *name)
+{
+    size_t slot = (size_t)name_hash(name) & (map->capacity - 1);
+    while (map->slots[slot].name != NULL && strcmp(map->slots[slot].name, name) != 0)
     {
-        printf("    %s\n", testRun->message);
+        slot = (slot + 1) & (map->capacity - 1);
     }
+    return &map->slots[slot];
 }
 
-static void stdout_report_action(YacuReportState state, YacuReportEvent reportEvent, const YacuSuite *suite, const YacuTestRun *testRun)
+static const NameSlot *name_map_find(const NameMap *map, const char *name)
 {
-    UNUSED(state);
-    switch (reportEvent)
+    if (map->count == 0)
     {
-    case SUITE_STARTED:
-        printf("#%s\n", suite->name);
-        break;
-    case TEST_RUN_STARTED:
-        printf("  ##%s\n", testRun->test->name);
-        break;
-    case TEST_RUN_FINISHED:
-        stdout_on_test_finished(testRun);
-        break;
-    default:
-        return;
+        return NULL;
     }
+    const NameSlot *slot = name_map_slot(map, name);
+    return slot->name != NULL ? slot : NULL;
 }
 
-static void on_suite_started(YacuReportPtr *reports, const YacuSuite *suite)
+static void name_map_put(NameMap *map, const char *name, size_t value)
 {
-    for (YacuReportPtr *reportPtr2Ptr = reports; !end_of_reports(*reportPtr2Ptr); reportPtr2Ptr++)
+    if (2 * (map->count + 1) > map->capacity)
     {
-        if (*reportPtr2Ptr == NULL)
+        NameMap grown = {NULL, map->capacity == 0 ? 64 : 2 * map->capacity, 0};
+        grown.slots = calloc(grown.capacity, sizeof(NameSlot));
+        if (grown.slots == NULL)
         {
-            continue;
+            exit(FATAL);
         }
-        YacuReport *report = *reportPtr2Ptr;
-        report->action(report->state, SUITE_STARTED, suite, NULL);
+        for (size_t i = 0; i < map->capacity; i++)
+        {
+            if (map->slots[i].name != NULL)
+            {
+                *name_map_slot(&grown, map->slots[i].name) = map->slots[i];
+                grown.count++;
+            }
+        }
+        free(map->slots);
+        *map = grown;
+    }
+    NameSlot *slot = name_map_slot(map, name);
+    if (slot->name == NULL)
+    {
+        slot->name = name;
+        map->count++;
     }
+    slot->value = value;
 }
 
-static void on_test_started(YacuReportPtr *reports, const YacuSuite *suite, const YacuTestRun *testRun)
+static const char *qualified_name(YacuMessageArena *scratch, const YacuSuite *suite, const YacuTest *test)
 {
-    for (YacuReportPtr *reportPtr2Ptr = reports; !end_of_reports(*reportPtr2Ptr); reportPtr2Ptr++)
+    arena_reset(scratch);
+    size_t offset = arena_store(scratch, "%s.%s", suite->name, test->name);
+    return scratch->data + offset;
+}
+
+// Files replayed by fuzz targets, sorted and kept as "/name" so that a name
+// is also the case suffix. The corpus is listed before workers fork.
+typedef struct Corpus
+{
+    const char *directory;
+    char **names;
+    size_t count;
+} Corpus;
+
+static Corpus *activeCorpus = NULL;
+
+// What globalSetup returned for the current run; forked tests inherit it.
+static void *activeGlobalState = NULL;
+
+#define CASE_SUFFIX_SIZE 24
+
+static const char *corpus_input_name(const YacuTest *test, size_t caseIndex)
+{
+    if (test->fuzz == NULL || activeCorpus == NULL || caseIndex >= activeCorpus->count)
     {
-        if (*reportPtr2Ptr == NULL)
-        {
-            continue;
-        }
-        YacuReport *report = *reportPtr2Ptr;
-        report->action(report->state, TEST_RUN_STARTED, suite, testRun);
+        return NULL;
     }
+    return activeCorpus->names[caseIndex];
 }
 
-static void on_test_finished(YacuReportPtr *reports, const YacuSuite *suite, const YacuTestRun *testRun)
+// Each case of a parameterized test, and each batch of a property test,
+// is reported as "Test/index"; corpus inputs as "Test/file". Reports may
+// run on the reporter thread, so the input name comes with the test run
+// rather than from activeCorpus.
+static const char *case_suffix(char *suffix, const YacuTest *test, size_t caseIndex, const char *inputName)
 {
-    for (YacuReportPtr *reportPtr2Ptr = reports; !end_of_reports(*reportPtr2Ptr); reportPtr2Ptr++)
+    suffix[0] = '\0';
+    if (inputName != NULL)
     {
-        if (*reportPtr2Ptr == NULL)
-        {
-            continue;
-        }
-        YacuReport *report = *reportPtr2Ptr;
-        report->action(report->state, TEST_RUN_FINISHED, suite, testRun);
+        return inputName;
+    }
+    if (test->caseCount > 0 || test->propertyCases > 0)
+    {
+        snprintf(suffix, CASE_SUFFIX_SIZE, "/%zu", caseIndex);
     }
+    return suffix;
 }
 
-static void on_suite_finished(YacuReportPtr *reports, const YacuSuite *suite)
+static const char *qualified_case_name(YacuMessageArena *scratch, const YacuSuite *suite, const YacuTest *test, size_t caseIndex, const char *inputName)
 {
-    for (YacuReportPtr *reportPtr2Ptr = reports; !end_of_reports(*reportPtr2Ptr); reportPtr2Ptr++)
+    char suffix[CASE_SUFFIX_SIZE];
+    arena_reset(scratch);
+    size_t offset = arena_store(scratch, "%s.%s%s", suite->name, test->name, case_suffix(suffix, test, caseIndex, inputName));
+    return scratch->data + offset;
+}
+
+static char *read_text_file(const char *path, bool required)
+{
+    FILE *file = fopen(path, "rb");
+    if (file == NULL)
     {
-        if (*reportPtr2Ptr == NULL)
+        if (required)
         {
-            continue;
+            exit(FILE_FAIL);
         }
-        YacuReport *report = *reportPtr2Ptr;
-        report->action(report->state, SUITE_FINISHED, suite, NULL);
+        return NULL;
     }
+    YacuMessageArena text = {NULL, 0, 0};
+    size_t read;
+    do
+    {
+        arena_reserve(&text, 4096);
+        read = fread(text.data + text.length, 1, text.capacity - text.length - 1, file);
+        text.length += read;
+    } while (read > 0);
+    fclose(file);
+    text.data[text.length] = '\0';
+    return text.data;
 }
 
-static void on_testing_finished(YacuReportPtr *reports)
+static void process_test_or_suite_arg(int i, int argc, char const *argv[], YacuOptions *options, bool withTest)
 {
-    for (YacuReportPtr *reportPtr2Ptr = reports; !end_of_reports(*reportPtr2Ptr); reportPtr2Ptr++)
+    if (argc <= i + (withTest ? 2 : 1))
     {
-        if (*reportPtr2Ptr == NULL)
-        {
-            continue;
-        }
-        YacuReport *report = *reportPtr2Ptr;
-        report->action(report->state, TESTING_FINISHED, NULL, NULL);
+        exit(WRONG_ARGS);
+    }
+    options->suiteName = argv[i + 1];
+    if (withTest)
+    {
+        options->testName = argv[i + 2];
     }
 }
 
-YacuReport END_OF_REPORTS = {NULL, NULL};
-
-static YacuStatus yacu_run_test(const YacuSuite *suite, const YacuTest *test, YacuReportPtr *reports, const void *runData)
+static long process_number_arg(int i, int argc, char const *argv[], long min, long max)
 {
-    YacuTestRun testRun = {.result = OK, .message = "", .reports = reports, .runData = runData, .test = test, .suite = suite};
-    on_test_started(reports, suite, &testRun);
-    test->fcn(&testRun);
-    on_test_finished(reports, suite, &testRun);
-    return testRun.result;
+    if (argc <= i + 1)
+    {
+        exit(WRONG_ARGS);
+    }
+    char *end = NULL;
+    long value = strtol(argv[i + 1], &end, 10);
+    if (end == argv[i + 1] || *end != '\0' || value < min || value > max)
+    {
+        exit(WRONG_ARGS);
+    }
+    return value;
 }
 
-void yacu_assert(YacuTestRun *testRun, bool condition, const char *fmt, ...)
+static uint64_t process_seed_arg(int i, int argc, char const *argv[])
 {
-    if (!(condition))
+    if (argc <= i + 1)
     {
-        testRun->result = TEST_FAILURE;
-
-        va_list args;
-        va_start(args, fmt);
-        vbuffer_append(testRun->message, YACU_TEST_RUN_MESSAGE_MAX_SIZE, fmt, args);
-        va_end(args);
-        if (testRun->result == TEST_FAILURE)
-        {
-            on_test_finished(testRun->reports, testRun->suite, testRun);
-            on_suite_finished(testRun->reports, testRun->suite);
-            on_testing_finished(testRun->reports);
-        }
-        exit(TEST_FAILURE);
+        exit(WRONG_ARGS);
+    }
+    char *end = NULL;
+    errno = 0;
+    unsigned long long value = strtoull(argv[i + 1], &end, 10);
+    if (end == argv[i + 1] || *end != '\0' || argv[i + 1][0] == '-' || errno == ERANGE)
+    {
+        exit(WRONG_ARGS);
     }
+    return (uint64_t)value;
 }
 
-static JUnitReport junit_initial_state(const char *jUnitPath)
+static double process_seconds_arg(int i, int argc, char const *argv[])
 {
-    JUnitReport jUnitInitial;
-    strcpy(jUnitInitial.jUnitBuffer, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
-                                     "<testsuites>\n");
-    jUnitInitial.jUnitPath = jUnitPath;
-    return jUnitInitial;
+    if (argc <= i + 1)
+    {
+        exit(WRONG_ARGS);
+    }
+    char *end = NULL;
+    double value = strtod(argv[i + 1], &end);
+    if (end == argv[i + 1] || *end != '\0' || !(value >= 0.0))
+    {
+        exit(WRONG_ARGS);
+    }
+    return value;
 }
 
-YacuStatus yacu_execute(YacuOptions options, const YacuSuite *suites)
+static void process_shard_arg(int i, int argc, char const *argv[], YacuOptions *options)
 {
-    YacuStatus runStatus = OK;
-    JUnitReport jUnitInitial = junit_initial_state(options.jUnitPath);
-    YacuReport jUnitReport = {&jUnitInitial, junit_report_action};
-    YacuReport stdoutReport = {NULL, stdout_report_action};
-
-    YacuReportPtr reports[] = {&jUnitReport, &stdoutReport, options.customReport, &END_OF_REPORTS};
+    if (argc <= i + 1)
+    {
+        exit(WRONG_ARGS);
+    }
+    char *end = NULL;
+    long index = strtol(argv[i + 1], &end, 10);
+    if (end == argv[i + 1] || *end != '/')
+    {
+        exit(WRONG_ARGS);
+    }
+    const char *countStart = end + 1;
+    long count = strtol(countStart, &end, 10);
+    if (end == countStart || *end != '\0' || count < 1 || index < 1 || index > count)
+    {
+        exit(WRONG_ARGS);
+    }
+    options->shardIndex = (size_t)index;
+    options->shardCount = (size_t)count;
+}
 
-    for (const YacuSuite *suiteIt = suites; !end_of_suites(*suiteIt); suiteIt++)
+void yacu_apply_cmd_args(YacuOptions *options, int argc, char const *argv[])
+{
+    for (int i = 1; i < argc; i++)
     {
-        if (options.suiteName == NULL || strcmp(options.suiteName, suiteIt->name) == 0)
+        if (strcmp(argv[i], "--test") == 0)
         {
-            on_suite_started(reports, suiteIt);
-            for (const YacuTest *testIt = suiteIt->tests; !end_of_tests(*testIt); testIt++)
-            {
-                if (options.testName == NULL || strcmp(options.testName, testIt->name) == 0)
-                {
-                    yacu_run_test(suiteIt, testIt, reports, options.runData);
-                }
-            }
+            process_test_or_suite_arg(i, argc, argv, options, true);
+            i = i + 2;
+        }
+        else if (strcmp(argv[i], "--suite") == 0)
+        {
+            process_test_or_suite_arg(i, argc, argv, options, false);
+            i++;
+        }
+        else if (strcmp(argv[i], "--slowest") == 0)
+        {
+            options->slowest = (size_t)process_number_arg(i, argc, argv, 0, LONG_MAX);
+            i++;
+        }
+        else if (strcmp(argv[i], "--benchmark-time") == 0)
+        {
+            options->benchmarkTime = process_seconds_arg(i, argc, argv);
+            i++;
+        }
+        else if (strcmp(argv[i], "--benchmark-warmups") == 0)
+        {
+            options->benchmarkWarmups = (size_t)process_number_arg(i, argc, argv, 0, LONG_MAX);
+            i++;
+        }
+        else if (strcmp(argv[i], "--benchmark-repetitions") == 0)
+        {
+            options->benchmarkRepetitions = (size_t)process_number_arg(i, argc, argv, 1, YACU_BENCHMARK_MAX_REPETITIONS);
+            i++;
         }
-        on_suite_finished(reports, suiteIt);
+        else if (strcmp(argv[i], "--property-cases") == 0)
+        {
+            options->propertyCases = (size_t)process_number_arg(i, argc, argv, 1, LONG_MAX);
+            i++;
+        }
+        else if (strcmp(argv[i], "--seed") == 0)
+        {
+            options->propertySeed = process_seed_arg(i, argc, argv);
+            i++;
+        }
+        else if (strcmp(argv[i], "--timeout") == 0)
+        {
+            options->timeout = process_seconds_arg(i, argc, argv);
+            i++;
+        }
+        else if (strcmp(argv[i], "--benchmark-baseline") == 0 || strcmp(argv[i], "--save-benchmark-baseline") == 0)
+        {
+            if (argc <= i + 1)
+            {
+                exit(WRONG_ARGS);
+            }
+            if (strcmp(argv[i], "--benchmark-baseline") == 0)
+            {
+                options->benchmarkBaseline = argv[i + 1];
+            }
+            else
+            {
+                options->saveBenchmarkBaseline = argv[i + 1];
+            }
+            i++;
+        }
+        else if (strcmp(argv[i], "--regression-threshold") == 0)
+        {
+            options->regressionThreshold = process_seconds_arg(i, argc, argv);
+            i++;
+        }
+        else if (strcmp(argv[i], "--junit") == 0)
+        {
+            if (argc <= i + 1)
+            {
+                exit(WRONG_ARGS);
+            }
+            options->jUnitPath = argv[i + 1];
+            i++;
+        }
+        else if (strcmp(argv[i], "--jobs") == 0)
+        {
+            options->jobs = (int)process_number_arg(i, argc, argv, 0, INT_MAX);
+            i++;
+        }
+        else if (strcmp(argv[i], "--filter") == 0 || strcmp(argv[i], "--filter-file") == 0)
+        {
+            if (argc <= i + 1)
+            {
+                exit(WRONG_ARGS);
+            }
+            if (strcmp(argv[i], "--filter") == 0)
+            {
+                options->filter = argv[i + 1];
+            }
+            else
+            {
+                options->filterFile = argv[i + 1];
+            }
+            i++;
+        }
+        else if (strcmp(argv[i], "--binary-log") == 0)
+        {
+            if (argc <= i + 1)
+            {
+                exit(WRONG_ARGS);
+            }
+            options->binaryLogPath = argv[i + 1];
+            i++;
+        }
+        else if (strcmp(argv[i], "--corpus") == 0)
+        {
+            if (argc <= i + 1)
+            {
+                exit(WRONG_ARGS);
+            }
+            options->corpusPath = argv[i + 1];
+            i++;
+        }
+        else if (strcmp(argv[i], "--cache") == 0 || strcmp(argv[i], "--shard-durations") == 0)
+        {
+            if (argc <= i + 1)
+            {
+                exit(WRONG_ARGS);
+            }
+            if (strcmp(argv[i], "--cache") == 0)
+            {
+                options->cachePath = argv[i + 1];
+            }
+            else
+            {
+                options->shardDurations = argv[i + 1];
+            }
+            i++;
+        }
+        else if (strcmp(argv[i], "--last-failed") == 0)
+        {
+            options->lastFailed = true;
+        }
+        else if (strcmp(argv[i], "--failed-first") == 0)
+        {
+            options->failedFirst = true;
+        }
+        else if (strcmp(argv[i], "--no-cache") == 0)
+        {
+            options->cachePath = NULL;
+        }
+        else if (strcmp(argv[i], "--shard") == 0)
+        {
+            process_shard_arg(i, argc, argv, options);
+            i++;
+        }
+        else if (strcmp(argv[i], "--async-reports") == 0)
+        {
+            options->asyncReports = true;
+        }
+        else if (strcmp(argv[i], "--perf") == 0)
+        {
+            options->perfCounters = true;
+        }
+        else if (strcmp(argv[i], "--isolated") == 0)
+        {
+            options->isolated = true;
+        }
+        else
+        {
+            exit(WRONG_ARGS);
+        }
+    }
+    if (options->lastFailed && options->cachePath == NULL)
+    {
+        exit(WRONG_ARGS);
+    }
+}
+
+#define UNUSED(x) (void)(x)
+
+static const char *const perfCounterNames[PERF_COUNTER_COUNT] = {
+    "cycles", "instructions", "branch_misses", "l1d_misses", "llc_misses", "task_clock_ns", "page_faults", "context_switches"};
+
+const char *yacu_status_name(YacuStatus status)
+{
+    switch (status)
+    {
+    case OK:
+        return "OK";
+    case TEST_FAILURE:
+        return "FAILURE";
+    case WRONG_ARGS:
+        return "WRONG_ARGS";
+    case FORK_FAIL:
+        return "FORK_FAIL";
+    case FILE_FAIL:
+        return "FILE_FAIL";
+    case TEST_ERROR:
+        return "ERROR";
+    case TEST_TIMEOUT:
+        return "TIMEOUT";
+    case FATAL:
+        return "FATAL";
+    }
+    return "UNKNOWN";
+}
+
+// The JUnit file is streamed through a bounded buffer. After every commit
+// the file ends with closing tags for all open elements, written after the
+// append cursor, so a run that dies midway still leaves a parseable file.
+typedef struct JUnitReport
+{
+    FILE *file;
+    char buffer[YACU_JUNIT_BUFFER_SIZE];
+    size_t buffered;
+    long cursor;
+    long suiteSummaryOffset;
+    bool inSuite;
+    size_t suiteTests;
+    size_t suiteFailures;
+    size_t suiteErrors;
+} JUnitReport;
+
+#define JUNIT_SUITE_SUMMARY_WIDTH 96
+
+static void junit_flush(JUnitReport *current)
+{
+    if (current->buffered > 0 && fwrite(current->buffer, 1, current->buffered, current->file) != current->buffered)
+    {
+        exit(FILE_FAIL);
+    }
+    current->cursor += (long)current->buffered;
+    current->buffered = 0;
+}
+
+static void junit_commit(JUnitReport *current)
+{
+    junit_flush(current);
+    const char *trailer = current->inSuite ? "  </testsuite>\n</testsuites>\n" : "</testsuites>\n";
+    if (fputs(trailer, current->file) == EOF || fseek(current->file, current->cursor, SEEK_SET) != 0)
+    {
+        exit(FILE_FAIL);
+    }
+    fflush(current->file);
+}
+
+static void junit_vwrite(JUnitReport *current, const char *format, va_list args)
+{
+    va_list retryArgs;
+    va_copy(retryArgs, args);
+    size_t available = YACU_JUNIT_BUFFER_SIZE - current->buffered;
+    int length = vsnprintf(current->buffer + current->buffered, available, format, args);
+    if (length >= 0 && (size_t)length < available)
+    {
+        current->buffered += (size_t)length;
+    }
+    else if (length >= 0)
+    {
+        junit_commit(current);
+        if ((size_t)length < YACU_JUNIT_BUFFER_SIZE)
+        {
+            vsnprintf(current->buffer, YACU_JUNIT_BUFFER_SIZE, format, retryArgs);
+            current->buffered = (size_t)length;
+        }
+        else
+        {
+            vfprintf(current->file, format, retryArgs);
+            current->cursor += (long)length;
+        }
+    }
+    va_end(retryArgs);
+}
+
+static void junit_write(JUnitReport *current, const char *format, ...)
+{
+    if (current->file == NULL)
+    {
+        return;
+    }
+    va_list args;
+    va_start(args, format);
+    junit_vwrite(current, format, args);
+    va_end(args);
+}
+
+static void junit_write_escaped(JUnitReport *current, const char *text)
+{
+    for (const char *it = text; current->file != NULL && *it != '\0'; it++)
+    {
+        unsigned char character = (unsigned char)*it;
+        if (YACU_JUNIT_BUFFER_SIZE - current->buffered < 8)
+        {
+            junit_commit(current);
+        }
+        char *end = current->buffer + current->buffered;
+        switch (character)
+        {
+        case '<':
+            current->buffered += (size_t)sprintf(end, "&lt;");
+            break;
+        case '>':
+            current->buffered += (size_t)sprintf(end, "&gt;");
+            break;
+        case '&':
+            current->buffered += (size_t)sprintf(end, "&amp;");
+            break;
+        case '"':
+            current->buffered += (size_t)sprintf(end, "&quot;");
+            break;
+        case '\n':
+        case '\r':
+        case '\t':
+            current->buffered += (size_t)sprintf(end, "&#%d;", character);
+            break;
+        default:
+            *end = character < 0x20 ? '?' : (char)character;
+            current->buffered++;
+            break;
+        }
+    }
+}
+
+static void junit_timestamp(char *timestamp, size_t size)
+{
+    time_t now = time(NULL);
+    struct tm *utc = gmtime(&now);
+    if (utc == NULL || strftime(timestamp, size, "%Y-%m-%dT%H:%M:%S", utc) == 0)
+    {
+        snprintf(timestamp, size, "1970-01-01T00:00:00");
+    }
+}
+
+static void junit_patch_suite_summary(JUnitReport *current, const YacuTestRun *suiteRun)
+{
+    char summary[JUNIT_SUITE_SUMMARY_WIDTH + 1];
+    int summaryLength = snprintf(summary, sizeof(summary), " tests=\"%zu\" failures=\"%zu\" errors=\"%zu\" time=\"%.6f\"",
+                                 current->suiteTests, current->suiteFailures, current->suiteErrors,
+                                 suiteRun == NULL ? 0.0 : suiteRun->duration);
+    if (summaryLength <= 0 || summaryLength > JUNIT_SUITE_SUMMARY_WIDTH)
+    {
+        return;
+    }
+    if (fseek(current->file, current->suiteSummaryOffset, SEEK_SET) != 0 ||
+        fwrite(summary, 1, (size_t)summaryLength, current->file) != (size_t)summaryLength ||
+        fseek(current->file, current->cursor, SEEK_SET) != 0)
+    {
+        exit(FILE_FAIL);
+    }
+}
+
+static double benchmark_throughput(double perIteration, const YacuBenchmarkStats *stats)
+{
+    return stats->median > 0.0 ? perIteration * 1e9 / stats->median : 0.0;
+}
+
+static void junit_benchmark_properties(JUnitReport *current, const YacuBenchmarkStats *stats)
+{
+    if (stats->repetitions == 0)
+    {
+        return;
+    }
+    junit_write(current,
+                "        <property name=\"benchmark.iterations\" value=\"%zu\"/>\n"
+                "        <property name=\"benchmark.repetitions\" value=\"%zu\"/>\n"
+                "        <property name=\"benchmark.min_ns\" value=\"%.3f\"/>\n"
+                "        <property name=\"benchmark.median_ns\" value=\"%.3f\"/>\n"
+                "        <property name=\"benchmark.mean_ns\" value=\"%.3f\"/>\n"
+                "        <property name=\"benchmark.p99_ns\" value=\"%.3f\"/>\n"
+                "        <property name=\"benchmark.stddev_ns\" value=\"%.3f\"/>\n",
+                stats->iterations, stats->repetitions, stats->min, stats->median, stats->mean, stats->p99, stats->stddev);
+    if (stats->bytesPerIteration > 0.0)
+    {
+        junit_write(current, "        <property name=\"benchmark.bytes_per_second\" value=\"%.3f\"/>\n",
+                    benchmark_throughput(stats->bytesPerIteration, stats));
+    }
+    if (stats->itemsPerIteration > 0.0)
+    {
+        junit_write(current, "        <property name=\"benchmark.items_per_second\" value=\"%.3f\"/>\n",
+                    benchmark_throughput(stats->itemsPerIteration, stats));
+    }
+    if (stats->baselineMedian > 0.0)
+    {
+        junit_write(current,
+                    "        <property name=\"benchmark.baseline_median_ns\" value=\"%.3f\"/>\n"
+                    "        <property name=\"benchmark.change\" value=\"%.4f\"/>\n"
+                    "        <property name=\"benchmark.p_value\" value=\"%.4f\"/>\n",
+                    stats->baselineMedian, stats->change, stats->pValue);
+    }
+}
+
+static void junit_on_test_finished(JUnitReport *current, const YacuTestRun *testRun)
+{
+    current->suiteTests++;
+    junit_write(current, "    <testcase classname=\"");
+    junit_write_escaped(current, testRun->suite->name);
+    junit_write(current, "\" name=\"");
+    junit_write_escaped(current, testRun->test->name);
+    char suffix[CASE_SUFFIX_SIZE];
+    junit_write_escaped(current, case_suffix(suffix, testRun->test, testRun->caseIndex, testRun->inputName));
+    junit_write(current, "\" time=\"%.6f\">\n", testRun->duration);
+    junit_write(current,
+                "      <properties>\n"
+                "        <property name=\"cpu.user\" value=\"%.6f\"/>\n"
+                "        <property name=\"cpu.system\" value=\"%.6f\"/>\n",
+                testRun->userTime, testRun->systemTime);
+    junit_benchmark_properties(current, &testRun->benchmark);
+    const YacuResourceUsage *usage = &testRun->usage;
+    if (usage->maxRssKb > 0)
+    {
+        junit_write(current,
+                    "        <property name=\"usage.max_rss_kb\" value=\"%ld\"/>\n"
+                    "        <property name=\"usage.minor_faults\" value=\"%ld\"/>\n"
+                    "        <property name=\"usage.major_faults\" value=\"%ld\"/>\n"
+                    "        <property name=\"usage.voluntary_switches\" value=\"%ld\"/>\n"
+                    "        <property name=\"usage.involuntary_switches\" value=\"%ld\"/>\n",
+                    usage->maxRssKb, usage->minorFaults, usage->majorFaults, usage->voluntarySwitches, usage->involuntarySwitches);
+    }
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++)
+    {
+        if (testRun->perf.available & (1u << i))
+        {
+            junit_write(current, "        <property name=\"perf.%s\" value=\"%.1f\"/>\n", perfCounterNames[i], testRun->perf.values[i]);
+        }
+    }
+    if (yacuAllocTracking)
+    {
+        const YacuAllocStats *allocs = &testRun->allocs;
+        junit_write(current,
+                    "        <property name=\"alloc.count\" value=\"%zu\"/>\n"
+                    "        <property name=\"alloc.bytes\" value=\"%zu\"/>\n"
+                    "        <property name=\"alloc.peak_bytes\" value=\"%zu\"/>\n"
+                    "        <property name=\"alloc.leaked_bytes\" value=\"%zu\"/>\n",
+                    allocs->allocations, allocs->allocatedBytes, allocs->peakBytes, allocs->leakedBytes);
+    }
+    junit_write(current, "      </properties>\n");
+    if (testRun->result != OK)
+    {
+        const char *element = testRun->result == TEST_FAILURE ? "failure" : "error";
+        if (testRun->result == TEST_FAILURE)
+        {
+            current->suiteFailures++;
+        }
+        else
+        {
+            current->suiteErrors++;
+        }
+        junit_write(current, "      <%s type=\"%s\" message=\"", element, yacu_status_name(testRun->result));
+        junit_write_escaped(current, testRun->message);
+        junit_write(current, "\"/>\n");
+    }
+    junit_write(current, "    </testcase>\n");
+}
+
+static void junit_report_action(YacuReportState state, YacuReportEvent reportEvent, const YacuSuite *suite, const YacuTestRun *testRun)
+{
+    JUnitReport *current = (JUnitReport *)state;
+    if (current->file == NULL)
+    {
+        return;
+    }
+    switch (reportEvent)
+    {
+    case SUITE_STARTED:
+    {
+        char timestamp[32];
+        junit_timestamp(timestamp, sizeof(timestamp));
+        junit_write(current, "  <testsuite package=\"\" id=\"0\" name=\"");
+        junit_write_escaped(current, suite->name);
+        junit_write(current, "\" timestamp=\"%s\" hostname=\"-\"", timestamp);
+        current->suiteSummaryOffset = current->cursor + (long)current->buffered;
+        junit_write(current, "%*s>\n", JUNIT_SUITE_SUMMARY_WIDTH, "");
+        junit_write(current, "    <properties/>\n");
+        current->inSuite = true;
+        current->suiteTests = 0;
+        current->suiteFailures = 0;
+        current->suiteErrors = 0;
+        junit_commit(current);
+        break;
+    }
+    case TEST_RUN_FINISHED:
+        junit_on_test_finished(current, testRun);
+        break;
+    case SUITE_FINISHED:
+        junit_write(current,
+                    "    <system-out/>\n"
+                    "    <system-err/>\n"
+                    "  </testsuite>\n");
+        current->inSuite = false;
+        junit_flush(current);
+        junit_patch_suite_summary(current, testRun);
+        junit_commit(current);
+        break;
+    case TESTING_FINISHED:
+        junit_commit(current);
+        fclose(current->file);
+        current->file = NULL;
+        break;
+    default:
+        return;
+    }
+}
+
+// Suite and test names are interned once per run, and each finished test is
+// appended with a single unbuffered write.
+typedef struct BinaryLogReport
+{
+    FILE *file;
+    uint64_t cursor;
+    NameMap suiteIds;
+    NameMap testIds;
+    char **names;
+    size_t nameCount;
+    YacuMessageArena qualifiedName;
+    YacuMessageArena records;
+} BinaryLogReport;
+
+static size_t log_record_size(size_t size)
+{
+    return (size + 7) & ~(size_t)7;
+}
+
+static uint64_t binary_log_text(BinaryLogReport *current, YacuLogRecordKind kind, uint32_t id, uint32_t suiteId, const char *text, size_t length)
+{
+    size_t size = log_record_size(sizeof(YacuLogText) + length + 1);
+    arena_reserve(&current->records, size);
+    char *record = current->records.data + current->records.length;
+    memset(record, 0, size);
+    YacuLogText header = {{(uint32_t)kind, (uint32_t)size}, id, suiteId, (uint64_t)length};
+    memcpy(record, &header, sizeof(header));
+    memcpy(record + sizeof(header), text, length);
+    uint64_t offset = current->cursor + current->records.length + sizeof(header);
+    current->records.length += size;
+    return offset;
+}
+
+static uint32_t binary_log_id(BinaryLogReport *current, NameMap *ids, const char *name, bool *added)
+{
+    const NameSlot *slot = name_map_find(ids, name);
+    *added = slot == NULL;
+    if (slot != NULL)
+    {
+        return (uint32_t)slot->value;
+    }
+    char **names = realloc(current->names, (current->nameCount + 1) * sizeof(char *));
+    char *copy = malloc(strlen(name) + 1);
+    if (names == NULL || copy == NULL)
+    {
+        exit(FATAL);
+    }
+    strcpy(copy, name);
+    current->names = names;
+    current->names[current->nameCount++] = copy;
+    uint32_t id = (uint32_t)ids->count;
+    name_map_put(ids, copy, id);
+    return id;
+}
+
+static void binary_log_on_test_finished(BinaryLogReport *current, const YacuSuite *suite, const YacuTestRun *testRun)
+{
+    arena_reset(&current->records);
+    bool added;
+    uint32_t suiteId = binary_log_id(current, &current->suiteIds, suite->name, &added);
+    if (added)
+    {
+        binary_log_text(current, LOG_SUITE_NAME, suiteId, suiteId, suite->name, strlen(suite->name));
+    }
+    const char *name = qualified_case_name(&current->qualifiedName, suite, testRun->test, testRun->caseIndex, testRun->inputName);
+    uint32_t testId = binary_log_id(current, &current->testIds, name, &added);
+    if (added)
+    {
+        const char *testName = name + strlen(suite->name) + 1;
+        binary_log_text(current, LOG_TEST_NAME, testId, suiteId, testName, strlen(testName));
+    }
+    uint64_t messageOffset = 0;
+    if (testRun->messageLength > 0)
+    {
+        messageOffset = binary_log_text(current, LOG_MESSAGE, 0, suiteId, testRun->message, testRun->messageLength);
+    }
+    YacuLogResult result = {{LOG_RESULT, (uint32_t)sizeof(YacuLogResult)}, suiteId, testId, (int32_t)testRun->result, 0,
+                            testRun->startTime, testRun->duration, testRun->userTime, testRun->systemTime,
+                            messageOffset, (uint64_t)testRun->messageLength};
+    arena_reserve(&current->records, sizeof(result));
+    memcpy(current->records.data + current->records.length, &result, sizeof(result));
+    current->records.length += sizeof(result);
+    if (fwrite(current->records.data, 1, current->records.length, current->file) != current->records.length)
+    {
+        exit(FILE_FAIL);
+    }
+    current->cursor += current->records.length;
+}
+
+static void binary_log_initialize(BinaryLogReport *current, const char *logPath)
+{
+    memset(current, 0, sizeof(BinaryLogReport));
+    if (logPath == NULL)
+    {
+        return;
+    }
+    current->file = fopen(logPath, "wb");
+    if (current->file == NULL)
+    {
+        exit(FILE_FAIL);
+    }
+    setvbuf(current->file, NULL, _IONBF, 0);
+    YacuLogHeader header = {.version = YACU_LOG_VERSION};
+    memcpy(header.magic, YACU_LOG_MAGIC, sizeof(header.magic));
+    if (fwrite(&header, 1, sizeof(header), current->file) != sizeof(header))
+    {
+        exit(FILE_FAIL);
+    }
+    current->cursor = sizeof(header);
+}
+
+static void binary_log_report_action(YacuReportState state, YacuReportEvent reportEvent, const YacuSuite *suite, const YacuTestRun *testRun)
+{
+    BinaryLogReport *current = state;
+    if (current->file == NULL)
+    {
+        return;
+    }
+    if (reportEvent == TEST_RUN_FINISHED && suite != NULL && testRun->test != NULL)
+    {
+        binary_log_on_test_finished(current, suite, testRun);
+    }
+    else if (reportEvent == TESTING_FINISHED)
+    {
+        fclose(current->file);
+        current->file = NULL;
+        for (size_t i = 0; i < current->nameCount; i++)
+        {
+            free(current->names[i]);
+        }
+        free(current->names);
+        free(current->suiteIds.slots);
+        free(current->testIds.slots);
+        arena_free(&current->qualifiedName);
+        arena_free(&current->records);
+    }
+}
+
+typedef struct LogTextTable
+{
+    const YacuLogText **texts;
+    size_t count;
+    size_t capacity;
+} LogTextTable;
+
+typedef struct ResultLog
+{
+    const char *data;
+    size_t size;
+    bool mapped;
+    LogTextTable suites;
+    LogTextTable tests;
+    const YacuLogResult **results;
+    size_t resultCount;
+    size_t resultCapacity;
+} ResultLog;
+
+static void log_text_table_put(LogTextTable *table, const YacuLogText *text)
+{
+    while (text->id >= table->capacity)
+    {
+        table->capacity = table->capacity == 0 ? 64 : 2 * table->capacity;
+        table->texts = realloc(table->texts, table->capacity * sizeof(YacuLogText *));
+        if (table->texts == NULL)
+        {
+            exit(FATAL);
+        }
+    }
+    while (table->count <= text->id)
+    {
+        table->texts[table->count++] = NULL;
+    }
+    table->texts[text->id] = text;
+}
+
+// Texts are printed by their recorded length, which log_open checked
+// against the log size, and never by their terminator.
+typedef struct LogString
+{
+    const char *data;
+    size_t length;
+} LogString;
+
+static LogString log_text(const LogTextTable *table, uint32_t id)
+{
+    if (id >= table->count || table->texts[id] == NULL)
+    {
+        LogString unknown = {"?", 1};
+        return unknown;
+    }
+    LogString text = {(const char *)(table->texts[id] + 1), (size_t)table->texts[id]->length};
+    return text;
+}
+
+static bool log_map(ResultLog *log, const char *logPath)
+{
+#ifdef FORK_AVAILABLE
+    int fd = open(logPath, O_RDONLY | O_CLOEXEC);
+    struct stat status;
+    if (fd < 0 || fstat(fd, &status) != 0 || status.st_size < (off_t)sizeof(YacuLogHeader))
+    {
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+        return false;
+    }
+    void *data = mmap(NULL, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+    {
+        return false;
+    }
+    madvise(data, (size_t)status.st_size, MADV_SEQUENTIAL);
+    log->data = data;
+    log->size = (size_t)status.st_size;
+    log->mapped = true;
+#else
+    FILE *file = fopen(logPath, "rb");
+    if (file == NULL)
+    {
+        return false;
+    }
+    YacuMessageArena content = {NULL, 0, 0};
+    size_t read;
+    do
+    {
+        arena_reserve(&content, 65536);
+        read = fread(content.data + content.length, 1, content.capacity - content.length - 1, file);
+        content.length += read;
+    } while (read > 0);
+    fclose(file);
+    log->data = content.data;
+    log->size = content.length;
+#endif
+    return true;
+}
+
+static void log_unmap(ResultLog *log)
+{
+#ifdef FORK_AVAILABLE
+    if (log->mapped)
+    {
+        munmap((void *)log->data, log->size);
+    }
+#else
+    free((void *)log->data);
+#endif
+    free(log->suites.texts);
+    free(log->tests.texts);
+    free(log->results);
+}
+
+static bool log_open(ResultLog *log, const char *logPath, int statusFilter)
+{
+    memset(log, 0, sizeof(ResultLog));
+    if (!log_map(log, logPath))
+    {
+        return false;
+    }
+    const YacuLogHeader *header = (const YacuLogHeader *)log->data;
+    if (log->size < sizeof(YacuLogHeader) || memcmp(header->magic, YACU_LOG_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != YACU_LOG_VERSION)
+    {
+        log_unmap(log);
+        return false;
+    }
+    size_t offset = sizeof(YacuLogHeader);
+    while (offset + sizeof(YacuLogRecord) <= log->size)
+    {
+        const YacuLogRecord *record = (const YacuLogRecord *)(log->data + offset);
+        if (record->size < sizeof(YacuLogRecord) || record->size % 8 != 0 || record->size > log->size - offset)
+        {
+            break;
+        }
+        const YacuLogText *text = (const YacuLogText *)record;
+        bool validText = record->size >= sizeof(YacuLogText) && text->length < record->size - sizeof(YacuLogText);
+        if (record->kind == LOG_SUITE_NAME && validText)
+        {
+            log_text_table_put(&log->suites, text);
+        }
+        else if (record->kind == LOG_TEST_NAME && validText)
+        {
+            log_text_table_put(&log->tests, text);
+        }
+        else if (record->kind == LOG_RESULT && record->size >= sizeof(YacuLogResult))
+        {
+            const YacuLogResult *result = (const YacuLogResult *)record;
+            if (statusFilter < 0 || result->status == statusFilter)
+            {
+                if (log->resultCount == log->resultCapacity)
+                {
+                    log->resultCapacity = log->resultCapacity == 0 ? 1024 : 2 * log->resultCapacity;
+                    log->results = realloc(log->results, log->resultCapacity * sizeof(YacuLogResult *));
+                    if (log->results == NULL)
+                    {
+                        exit(FATAL);
+                    }
+                }
+                log->results[log->resultCount++] = result;
+            }
+        }
+        offset += record->size;
+    }
+    return true;
+}
+
+static LogString log_message(const ResultLog *log, const YacuLogResult *result)
+{
+    LogString message = {"", 0};
+    if (result->messageLength > 0 && result->messageOffset < log->size && result->messageLength <= log->size - result->messageOffset)
+    {
+        message.data = log->data + result->messageOffset;
+        message.length = (size_t)result->messageLength;
+    }
+    return message;
+}
+
+static void fputs_escaped(FILE *output, LogString text, bool json)
+{
+    for (size_t i = 0; i < text.length; i++)
+    {
+        unsigned char character = (unsigned char)text.data[i];
+        if (json && (character == '"' || character == '\\'))
+        {
+            fprintf(output, "\\%c", character);
+        }
+        else if (json && character < 0x20)
+        {
+            fprintf(output, "\\u%04x", character);
+        }
+        else if (!json && (character == '<' || character == '>' || character == '&' || character == '"'))
+        {
+            fputs(character == '<' ? "&lt;" : character == '>' ? "&gt;" : character == '&' ? "&amp;" : "&quot;", output);
+        }
+        else if (!json && (character == '\n' || character == '\r' || character == '\t'))
+        {
+            fprintf(output, "&#%d;", character);
+        }
+        else
+        {
+            fputc(!json && character < 0x20 ? '?' : (char)character, output);
+        }
+    }
+}
+
+static void log_write_junit(const ResultLog *log, FILE *output)
+{
+    fprintf(output, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<testsuites>\n");
+    for (size_t first = 0; first < log->resultCount;)
+    {
+        uint32_t suiteId = log->results[first]->suiteId;
+        size_t last = first;
+        size_t failures = 0;
+        size_t errors = 0;
+        double time = 0.0;
+        for (; last < log->resultCount && log->results[last]->suiteId == suiteId; last++)
+        {
+            failures += log->results[last]->status == TEST_FAILURE ? 1 : 0;
+            errors += log->results[last]->status != TEST_FAILURE && log->results[last]->status != OK ? 1 : 0;
+            time += log->results[last]->duration;
+        }
+        fprintf(output, "  <testsuite name=\"");
+        fputs_escaped(output, log_text(&log->suites, suiteId), false);
+        fprintf(output, "\" tests=\"%zu\" failures=\"%zu\" errors=\"%zu\" time=\"%.6f\">\n", last - first, failures, errors, time);
+        for (; first < last; first++)
+        {
+            const YacuLogResult *result = log->results[first];
+            fprintf(output, "    <testcase classname=\"");
+            fputs_escaped(output, log_text(&log->suites, suiteId), false);
+            fprintf(output, "\" name=\"");
+            fputs_escaped(output, log_text(&log->tests, result->testId), false);
+            fprintf(output, "\" time=\"%.6f\"", result->duration);
+            if (result->status == OK)
+            {
+                fprintf(output, "/>\n");
+                continue;
+            }
+            fprintf(output, ">\n      <%s type=\"%s\" message=\"", result->status == TEST_FAILURE ? "failure" : "error",
+                    yacu_status_name((YacuStatus)result->status));
+            fputs_escaped(output, log_message(log, result), false);
+            fprintf(output, "\"/>\n    </testcase>\n");
+        }
+        fprintf(output, "  </testsuite>\n");
+    }
+    fprintf(output, "</testsuites>\n");
+}
+
+static void log_write_json_lines(const ResultLog *log, FILE *output)
+{
+    for (size_t i = 0; i < log->resultCount; i++)
+    {
+        const YacuLogResult *result = log->results[i];
+        fprintf(output, "{\"suite\":\"");
+        fputs_escaped(output, log_text(&log->suites, result->suiteId), true);
+        fprintf(output, "\",\"test\":\"");
+        fputs_escaped(output, log_text(&log->tests, result->testId), true);
+        fprintf(output, "\",\"status\":\"%s\",\"start\":%.9f,\"duration\":%.9f,\"user\":%.9f,\"system\":%.9f,\"message\":\"",
+                yacu_status_name((YacuStatus)result->status), result->startTime, result->duration, result->userTime, result->systemTime);
+        fputs_escaped(output, log_message(log, result), true);
+        fprintf(output, "\"}\n");
+    }
+}
+
+static const YacuStatus logStatuses[] = {OK, TEST_FAILURE, WRONG_ARGS, FORK_FAIL, FILE_FAIL, TEST_ERROR, TEST_TIMEOUT, FATAL};
+
+#define LOG_STATUS_COUNT (sizeof(logStatuses) / sizeof(logStatuses[0]))
+
+static void log_write_summary(const ResultLog *log, FILE *output)
+{
+    size_t counts[LOG_STATUS_COUNT] = {0};
+    double total = 0.0;
+    const YacuLogResult *slowest = NULL;
+    for (size_t i = 0; i < log->resultCount; i++)
+    {
+        const YacuLogResult *result = log->results[i];
+        for (size_t j = 0; j < LOG_STATUS_COUNT; j++)
+        {
+            counts[j] += result->status == (int32_t)logStatuses[j] ? 1 : 0;
+        }
+        total += result->duration;
+        slowest = slowest == NULL || result->duration > slowest->duration ? result : slowest;
+    }
+    fprintf(output, "Tests: %zu\n", log->resultCount);
+    for (size_t j = 0; j < LOG_STATUS_COUNT; j++)
+    {
+        if (counts[j] > 0)
+        {
+            fprintf(output, "  %s: %zu\n", yacu_status_name(logStatuses[j]), counts[j]);
+        }
+    }
+    fprintf(output, "Total time: %.3f ms\n", 1e3 * total);
+    if (slowest != NULL)
+    {
+        fprintf(output, "Mean time: %.3f ms\n", 1e3 * total / (double)log->resultCount);
+        LogString suiteName = log_text(&log->suites, slowest->suiteId);
+        LogString testName = log_text(&log->tests, slowest->testId);
+        fprintf(output, "Slowest: %.*s.%.*s %.3f ms\n", (int)suiteName.length, suiteName.data, (int)testName.length, testName.data,
+                1e3 * slowest->duration);
+    }
+}
+
+YacuStatus yacu_convert_log(const char *logPath, YacuLogFormat format, const char *statusFilter, FILE *output)
+{
+    int status = -1;
+    for (size_t j = 0; j < LOG_STATUS_COUNT && statusFilter != NULL; j++)
+    {
+        status = strcmp(statusFilter, yacu_status_name(logStatuses[j])) == 0 ? (int)logStatuses[j] : status;
+    }
+    if (statusFilter != NULL && status < 0)
+    {
+        return WRONG_ARGS;
+    }
+    ResultLog log;
+    if (!log_open(&log, logPath, status))
+    {
+        return FILE_FAIL;
+    }
+    switch (format)
+    {
+    case LOG_JUNIT:
+        log_write_junit(&log, output);
+        break;
+    case LOG_JSON_LINES:
+        log_write_json_lines(&log, output);
+        break;
+    case LOG_SUMMARY:
+        log_write_summary(&log, output);
+        break;
+    }
+    log_unmap(&log);
+    return fflush(output) == 0 ? OK : FILE_FAIL;
+}
+
+static void stdout_on_test_finished(const YacuTestRun *testRun)
+{
+    printf("    %s\n", yacu_status_name(testRun->result));
+    if (testRun->messageLength > 0)
+    {
+        printf("    %s\n", testRun->message);
+    }
+    printf("    %.3f ms (user %.3f ms, sys %.3f ms", 1e3 * testRun->duration, 1e3 * testRun->userTime, 1e3 * testRun->systemTime);
+    if (testRun->overhead > 0.0)
+    {
+        printf(", +%.3f ms process overhead", 1e3 * testRun->overhead);
+    }
+    printf(")\n");
+    const YacuBenchmarkStats *stats = &testRun->benchmark;
+    if (stats->repetitions > 0)
+    {
+        printf("    %.2f ns/op median (min %.2f, mean %.2f, p99 %.2f, stddev %.2f) over %zu x %zu iterations\n",
+               stats->median, stats->min, stats->mean, stats->p99, stats->stddev, stats->repetitions, stats->iterations);
+    }
+    if (stats->repetitions > 0 && stats->bytesPerIteration > 0.0)
+    {
+        printf("    %.3f MB/s\n", 1e-6 * benchmark_throughput(stats->bytesPerIteration, stats));
+    }
+    if (stats->repetitions > 0 && stats->itemsPerIteration > 0.0)
+    {
+        printf("    %.3f M items/s\n", 1e-6 * benchmark_throughput(stats->itemsPerIteration, stats));
+    }
+    if (stats->baselineMedian > 0.0)
+    {
+        printf("    %+.1f%% vs baseline %.2f ns/op (p=%.4f)\n", 100.0 * stats->change, stats->baselineMedian, stats->pValue);
+    }
+    const YacuResourceUsage *usage = &testRun->usage;
+    if (usage->maxRssKb > 0)
+    {
+        printf("    max RSS %ld KB, %ld minor / %ld major faults, %ld voluntary / %ld involuntary switches\n",
+               usage->maxRssKb, usage->minorFaults, usage->majorFaults, usage->voluntarySwitches, usage->involuntarySwitches);
+    }
+    if (testRun->perf.available != 0)
+    {
+        printf("    perf%s:", stats->repetitions > 0 ? " per iteration" : "");
+        for (int i = 0; i < PERF_COUNTER_COUNT; i++)
+        {
+            if (testRun->perf.available & (1u << i))
+            {
+                printf(" %s %.1f", perfCounterNames[i], testRun->perf.values[i]);
+            }
+        }
+        printf("\n");
+    }
+    const YacuAllocStats *allocs = &testRun->allocs;
+    if (allocs->allocations > 0 || allocs->frees > 0)
+    {
+        printf("    %zu allocations, %zu bytes (peak %zu, leaked %zu), %zu frees\n",
+               allocs->allocations, allocs->allocatedBytes, allocs->peakBytes, allocs->leakedBytes, allocs->frees);
+    }
+}
+
+typedef struct SlowTest
+{
+    const YacuSuite *suite;
+    const YacuTest *test;
+    size_t caseIndex;
+    const char *inputName;
+    double duration;
+} SlowTest;
+
+typedef struct StdoutReport
+{
+    SlowTest *slowestTests;
+    size_t slowestCapacity;
+    size_t slowestCount;
+    YacuResourceUsage usage;
+    SlowTest largestTest;
+} StdoutReport;
+
+static void stdout_track_usage(StdoutReport *current, const YacuTestRun *testRun)
+{
+    const YacuResourceUsage *usage = &testRun->usage;
+    if (usage->maxRssKb > current->usage.maxRssKb)
+    {
+        current->usage.maxRssKb = usage->maxRssKb;
+        SlowTest largestTest = {testRun->suite, testRun->test, testRun->caseIndex, testRun->inputName, testRun->duration};
+        current->largestTest = largestTest;
+    }
+    current->usage.minorFaults += usage->minorFaults;
+    current->usage.majorFaults += usage->majorFaults;
+    current->usage.voluntarySwitches += usage->voluntarySwitches;
+    current->usage.involuntarySwitches += usage->involuntarySwitches;
+}
+
+static void stdout_track_slowest(StdoutReport *current, const YacuTestRun *testRun)
+{
+    if (current->slowestCapacity == 0)
+    {
+        return;
+    }
+    size_t position = current->slowestCount;
+    while (position > 0 && current->slowestTests[position - 1].duration < testRun->duration)
+    {
+        position--;
+    }
+    if (position == current->slowestCapacity)
+    {
+        return;
+    }
+    size_t last = current->slowestCount < current->slowestCapacity ? current->slowestCount : current->slowestCapacity - 1;
+    memmove(current->slowestTests + position + 1, current->slowestTests + position, (last - position) * sizeof(SlowTest));
+    SlowTest slowTest = {testRun->suite, testRun->test, testRun->caseIndex, testRun->inputName, testRun->duration};
+    current->slowestTests[position] = slowTest;
+    current->slowestCount = last + 1;
+}
+
+static void stdout_on_testing_finished(const StdoutReport *current, const YacuTestRun *summaryRun)
+{
+    if (summaryRun != NULL)
+    {
+        printf("Total time: %.3f ms\n", 1e3 * summaryRun->duration);
+    }
+    const YacuResourceUsage *usage = &current->usage;
+    char suffix[CASE_SUFFIX_SIZE];
+    if (usage->maxRssKb > 0)
+    {
+        printf("Max RSS: %ld KB (%s.%s%s), %ld minor / %ld major faults, %ld voluntary / %ld involuntary switches\n",
+               usage->maxRssKb, current->largestTest.suite->name, current->largestTest.test->name,
+               case_suffix(suffix, current->largestTest.test, current->largestTest.caseIndex, current->largestTest.inputName),
+               usage->minorFaults, usage->majorFaults, usage->voluntarySwitches, usage->involuntarySwitches);
+    }
+    if (current->slowestCount > 0)
+    {
+        printf("Slowest %zu tests:\n", current->slowestCount);
+    }
+    for (size_t i = 0; i < current->slowestCount; i++)
+    {
+        const SlowTest *slowTest = &current->slowestTests[i];
+        printf("  %10.3f ms  %s.%s%s\n", 1e3 * slowTest->duration, slowTest->suite->name, slowTest->test->name,
+               case_suffix(suffix, slowTest->test, slowTest->caseIndex, slowTest->inputName));
+    }
+}
+
+static void stdout_report_action(YacuReportState state, YacuReportEvent reportEvent, const YacuSuite *suite, const YacuTestRun *testRun)
+{
+    StdoutReport *current = (StdoutReport *)state;
+    switch (reportEvent)
+    {
+    case SUITE_STARTED:
+        printf("#%s\n", suite->name);
+        break;
+    case TEST_RUN_STARTED:
+    {
+        char suffix[CASE_SUFFIX_SIZE];
+        printf("  ##%s%s\n", testRun->test->name, case_suffix(suffix, testRun->test, testRun->caseIndex, testRun->inputName));
+        break;
+    }
+    case TEST_RUN_FINISHED:
+        stdout_on_test_finished(testRun);
+        stdout_track_slowest(current, testRun);
+        stdout_track_usage(current, testRun);
+        break;
+    case SUITE_FINISHED:
+        if (testRun != NULL)
+        {
+            printf("  %.3f ms (user %.3f ms, sys %.3f ms)\n", 1e3 * testRun->duration, 1e3 * testRun->userTime, 1e3 * testRun->systemTime);
+        }
+        break;
+    case TESTING_FINISHED:
+        stdout_on_testing_finished(current, testRun);
+        break;
+    default:
+        return;
+    }
+}
+
+static void report_event(YacuReportPtr *reports, YacuReportEvent reportEvent, const YacuSuite *suite, const YacuTestRun *testRun)
+{
+    for (YacuReportPtr *reportPtr2Ptr = reports; !end_of_reports(*reportPtr2Ptr); reportPtr2Ptr++)
+    {
+        if (*reportPtr2Ptr == NULL)
+        {
+            continue;
+        }
+        YacuReport *report = *reportPtr2Ptr;
+        report->action(report->state, reportEvent, suite, testRun);
+    }
+}
+
+static void on_suite_started(YacuReportPtr *reports, const YacuSuite *suite)
+{
+    report_event(reports, SUITE_STARTED, suite, NULL);
+}
+
+static void on_test_started(YacuReportPtr *reports, const YacuSuite *suite, const YacuTestRun *testRun)
+{
+    report_event(reports, TEST_RUN_STARTED, suite, testRun);
+}
+
+static void on_test_finished(YacuReportPtr *reports, const YacuSuite *suite, const YacuTestRun *testRun)
+{
+    report_event(reports, TEST_RUN_FINISHED, suite, testRun);
+}
+
+static void on_suite_finished(YacuReportPtr *reports, const YacuSuite *suite, const YacuTestRun *suiteRun)
+{
+    report_event(reports, SUITE_FINISHED, suite, suiteRun);
+}
+
+static void on_testing_finished(YacuReportPtr *reports, const YacuTestRun *summaryRun)
+{
+    report_event(reports, TESTING_FINISHED, NULL, summaryRun);
+}
+
+YacuReport END_OF_REPORTS = {NULL, NULL};
+
+#ifdef FORK_AVAILABLE
+// Events are copied into a single-producer single-consumer ring and handed
+// to the reports by a reporter thread, so slow reports do not stall tests.
+// The producer only waits when the ring is full; TESTING_FINISHED drains it.
+typedef struct QueuedEvent
+{
+    YacuReportEvent reportEvent;
+    const YacuSuite *suite;
+    bool hasRun;
+    YacuTestRun run;
+} QueuedEvent;
+
+typedef struct AsyncReport
+{
+    YacuReportPtr *reports;
+    pthread_t thread;
+    _Atomic size_t head;
+    _Atomic size_t tail;
+    QueuedEvent events[YACU_REPORT_QUEUE_SIZE];
+} AsyncReport;
+
+static void async_backoff(unsigned *spins)
+{
+    if (++*spins < 64)
+    {
+        sched_yield();
+        return;
+    }
+    struct timespec pause = {0, 50000};
+    nanosleep(&pause, NULL);
+}
+
+static void *async_report_loop(void *state)
+{
+    AsyncReport *async = state;
+    for (bool finished = false; !finished;)
+    {
+        size_t tail = atomic_load_explicit(&async->tail, memory_order_relaxed);
+        unsigned spins = 0;
+        while (atomic_load_explicit(&async->head, memory_order_acquire) == tail)
+        {
+            async_backoff(&spins);
+        }
+        QueuedEvent *queued = &async->events[tail % YACU_REPORT_QUEUE_SIZE];
+        report_event(async->reports, queued->reportEvent, queued->suite, queued->hasRun ? &queued->run : NULL);
+        finished = queued->reportEvent == TESTING_FINISHED;
+        if (queued->hasRun && queued->run.messageLength > 0)
+        {
+            free((char *)queued->run.message);
+        }
+        atomic_store_explicit(&async->tail, tail + 1, memory_order_release);
+    }
+    return NULL;
+}
+
+static void async_report_action(YacuReportState state, YacuReportEvent reportEvent, const YacuSuite *suite, const YacuTestRun *testRun)
+{
+    AsyncReport *async = state;
+    size_t head = atomic_load_explicit(&async->head, memory_order_relaxed);
+    unsigned spins = 0;
+    while (head - atomic_load_explicit(&async->tail, memory_order_acquire) == YACU_REPORT_QUEUE_SIZE)
+    {
+        async_backoff(&spins);
+    }
+    QueuedEvent *queued = &async->events[head % YACU_REPORT_QUEUE_SIZE];
+    queued->reportEvent = reportEvent;
+    queued->suite = suite;
+    queued->hasRun = testRun != NULL;
+    if (testRun != NULL)
+    {
+        // Only the benchmark samples in use are copied; the rest of the
+        // array is what makes a run large. The message lives in an arena
+        // that the next test reuses.
+        size_t samplesOffset = offsetof(YacuTestRun, benchmark.samples);
+        size_t samplesEnd = samplesOffset + sizeof(testRun->benchmark.samples);
+        size_t repetitions = testRun->benchmark.repetitions < YACU_BENCHMARK_MAX_REPETITIONS ? testRun->benchmark.repetitions : YACU_BENCHMARK_MAX_REPETITIONS;
+        memcpy(&queued->run, testRun, samplesOffset);
+        memcpy(queued->run.benchmark.samples, testRun->benchmark.samples, repetitions * sizeof(double));
+        memcpy((char *)&queued->run + samplesEnd, (const char *)testRun + samplesEnd, sizeof(YacuTestRun) - samplesEnd);
+        queued->run.arena = NULL;
+        queued->run.abortJump = NULL;
+        queued->run.message = "";
+        if (testRun->messageLength > 0)
+        {
+            char *message = malloc(testRun->messageLength + 1);
+            if (message == NULL)
+            {
+                exit(FATAL);
+            }
+            memcpy(message, testRun->message, testRun->messageLength + 1);
+            queued->run.message = message;
+        }
+    }
+    atomic_store_explicit(&async->head, head + 1, memory_order_release);
+    if (reportEvent == TESTING_FINISHED)
+    {
+        pthread_join(async->thread, NULL);
+    }
+}
+
+static AsyncReport *async_start(YacuReportPtr *reports)
+{
+    AsyncReport *async = calloc(1, sizeof(AsyncReport));
+    if (async == NULL)
+    {
+        exit(FATAL);
+    }
+    async->reports = reports;
+    atomic_init(&async->head, 0);
+    atomic_init(&async->tail, 0);
+    if (pthread_create(&async->thread, NULL, async_report_loop, async) != 0)
+    {
+        free(async);
+        return NULL;
+    }
+    return async;
+}
+#endif
+
+static YacuStatus merge_status(YacuStatus runStatus, YacuStatus testStatus)
+{
+    return runStatus == OK ? testStatus : runStatus;
+}
+
+typedef struct RunReporter
+{
+    YacuReportPtr *reports;
+    const YacuSuite *suite;
+    YacuStatus suiteResult;
+    double suiteStart;
+    double suiteEnd;
+    double suiteUserTime;
+    double suiteSystemTime;
+} RunReporter;
+
+static void reporter_leave_suite(RunReporter *reporter)
+{
+    if (reporter->suite == NULL)
+    {
+        return;
+    }
+    YacuTestRun suiteRun = {.result = reporter->suiteResult,
+                            .message = "",
+                            .reports = reporter->reports,
+                            .suite = reporter->suite,
+                            .test = NULL,
+                            .startTime = reporter->suiteStart,
+                            .duration = reporter->suiteEnd - reporter->suiteStart,
+                            .userTime = reporter->suiteUserTime,
+                            .systemTime = reporter->suiteSystemTime};
+    on_suite_finished(reporter->reports, reporter->suite, &suiteRun);
+    reporter->suite = NULL;
+}
+
+static void reporter_enter_suite(RunReporter *reporter, const YacuSuite *suite)
+{
+    if (reporter->suite == suite)
+    {
+        return;
+    }
+    reporter_leave_suite(reporter);
+    reporter->suite = suite;
+    reporter->suiteResult = OK;
+    reporter->suiteStart = 0.0;
+    reporter->suiteEnd = 0.0;
+    reporter->suiteUserTime = 0.0;
+    reporter->suiteSystemTime = 0.0;
+    on_suite_started(reporter->reports, suite);
+}
+
+static void reporter_record(RunReporter *reporter, const YacuTestRun *testRun)
+{
+    double testEnd = testRun->startTime + testRun->duration;
+    if (reporter->suiteEnd == 0.0 || testRun->startTime < reporter->suiteStart)
+    {
+        reporter->suiteStart = testRun->startTime;
+    }
+    if (testEnd > reporter->suiteEnd)
+    {
+        reporter->suiteEnd = testEnd;
+    }
+    reporter->suiteUserTime += testRun->userTime;
+    reporter->suiteSystemTime += testRun->systemTime;
+    reporter->suiteResult = merge_status(reporter->suiteResult, testRun->result);
+}
+
+#define YACU_BENCHMARK_MAX_ITERATIONS 1000000000
+
+static double benchmark_repetition(YacuTestRun *testRun, YacuBenchmarkFcn benchmark, size_t iterations)
+{
+    double start = yacu_now();
+    benchmark(testRun, iterations);
+    return yacu_now() - start;
+}
+
+static size_t benchmark_calibrate(YacuTestRun *testRun, YacuBenchmarkFcn benchmark, double targetTime)
+{
+    size_t iterations = 1;
+    for (;;)
+    {
+        double elapsed = benchmark_repetition(testRun, benchmark, iterations);
+        if (elapsed >= targetTime || iterations >= YACU_BENCHMARK_MAX_ITERATIONS)
+        {
+            return iterations;
+        }
+        double scale = elapsed > 0.0 ? 1.2 * targetTime / elapsed : 10.0;
+        scale = scale > 10.0 ? 10.0 : scale;
+        size_t next = (size_t)((double)iterations * scale);
+        iterations = next > iterations ? next : iterations + 1;
+        iterations = iterations < YACU_BENCHMARK_MAX_ITERATIONS ? iterations : YACU_BENCHMARK_MAX_ITERATIONS;
+    }
+}
+
+#ifdef __linux__
+typedef struct PerfEvent
+{
+    uint32_t type;
+    uint64_t config;
+} PerfEvent;
+
+#define PERF_CACHE_READ_MISS(cache) \
+    ((cache) | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16))
+
+static const PerfEvent perfEvents[PERF_COUNTER_COUNT] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {PERF_TYPE_HW_CACHE, PERF_CACHE_READ_MISS(PERF_COUNT_HW_CACHE_L1D)},
+    {PERF_TYPE_HW_CACHE, PERF_CACHE_READ_MISS(PERF_COUNT_HW_CACHE_LL)},
+    {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK},
+    {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS},
+    {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES}};
+
+// Counters measure the thread that opened them, so forked workers reopen
+// their own instead of using the inherited descriptors.
+typedef struct PerfSession
+{
+    YacuProcessHandle pid;
+    int fds[PERF_COUNTER_COUNT];
+    unsigned available;
+} PerfSession;
+
+static PerfSession perfSession = {0};
+
+static void perf_open()
+{
+    if (perfSession.pid == getpid())
+    {
+        return;
+    }
+    for (int i = 0; i < PERF_COUNTER_COUNT && perfSession.pid != 0; i++)
+    {
+        if (perfSession.available & (1u << i))
+        {
+            close(perfSession.fds[i]);
+        }
+    }
+    perfSession.pid = getpid();
+    perfSession.available = 0;
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++)
+    {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = perfEvents[i].type;
+        attr.config = perfEvents[i].config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        perfSession.fds[i] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC);
+        if (perfSession.fds[i] >= 0)
+        {
+            perfSession.available |= 1u << i;
+        }
+    }
+}
+#endif
+
+static void perf_start()
+{
+#ifdef __linux__
+    perf_open();
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++)
+    {
+        if (perfSession.available & (1u << i))
+        {
+            ioctl(perfSession.fds[i], PERF_EVENT_IOC_RESET, 0);
+            ioctl(perfSession.fds[i], PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+#endif
+}
+
+static void perf_stop(YacuPerfCounters *counters, double divisor)
+{
+    memset(counters, 0, sizeof(YacuPerfCounters));
+#ifdef __linux__
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++)
+    {
+        uint64_t reading[3];
+        if (!(perfSession.available & (1u << i)))
+        {
+            continue;
+        }
+        ioctl(perfSession.fds[i], PERF_EVENT_IOC_DISABLE, 0);
+        if (read(perfSession.fds[i], reading, sizeof(reading)) != (ssize_t)sizeof(reading))
+        {
+            continue;
+        }
+        // Scale up when the kernel multiplexed the counter.
+        double value = (double)reading[0];
+        if (reading[2] > 0 && reading[2] < reading[1])
+        {
+            value *= (double)reading[1] / (double)reading[2];
+        }
+        counters->values[i] = value / divisor;
+        counters->available |= 1u << i;
+    }
+#else
+    UNUSED(divisor);
+#endif
+}
+
+static int compare_doubles(const void *left, const void *right)
+{
+    double leftValue = *(const double *)left;
+    double rightValue = *(const double *)right;
+    return (leftValue > rightValue) - (leftValue < rightValue);
+}
+
+static void benchmark_statistics(YacuBenchmarkStats *stats)
+{
+    size_t count = stats->repetitions;
+    double sorted[YACU_BENCHMARK_MAX_REPETITIONS];
+    memcpy(sorted, stats->samples, count * sizeof(double));
+    qsort(sorted, count, sizeof(double), compare_doubles);
+    double sum = 0.0;
+    for (size_t i = 0; i < count; i++)
+    {
+        sum += sorted[i];
+    }
+    stats->min = sorted[0];
+    stats->median = count % 2 == 1 ? sorted[count / 2] : 0.5 * (sorted[count / 2 - 1] + sorted[count / 2]);
+    stats->mean = sum / (double)count;
+    size_t p99Rank = (99 * count + 99) / 100;
+    stats->p99 = sorted[p99Rank - 1];
+    double squares = 0.0;
+    for (size_t i = 0; i < count; i++)
+    {
+        squares += (sorted[i] - stats->mean) * (sorted[i] - stats->mean);
+    }
+    stats->stddev = count > 1 ? sqrt(squares / (double)(count - 1)) : 0.0;
+}
+
+// Benchmark samples keyed by "Suite.Test", one "name<TAB>count<TAB>samples"
+// line per benchmark.
+typedef struct BaselineEntry
+{
+    char *name;
+    size_t count;
+    double samples[YACU_BENCHMARK_MAX_REPETITIONS];
+} BaselineEntry;
+
+typedef struct BenchmarkBaseline
+{
+    const char *path;
+    BaselineEntry *entries;
+    size_t count;
+    size_t capacity;
+    NameMap index;
+    YacuMessageArena qualifiedName;
+} BenchmarkBaseline;
+
+// Read by benchmarks while a run with a baseline is executing.
+static BenchmarkBaseline *activeBaseline = NULL;
+
+static BaselineEntry *baseline_entry(BenchmarkBaseline *baseline, const char *name)
+{
+    const NameSlot *slot = name_map_find(&baseline->index, name);
+    if (slot != NULL)
+    {
+        return &baseline->entries[slot->value];
+    }
+    if (baseline->count == baseline->capacity)
+    {
+        baseline->capacity = baseline->capacity == 0 ? 16 : 2 * baseline->capacity;
+        baseline->entries = realloc(baseline->entries, baseline->capacity * sizeof(BaselineEntry));
+        if (baseline->entries == NULL)
+        {
+            exit(FATAL);
+        }
+    }
+    BaselineEntry *entry = &baseline->entries[baseline->count];
+    memset(entry, 0, sizeof(BaselineEntry));
+    entry->name = malloc(strlen(name) + 1);
+    if (entry->name == NULL)
+    {
+        exit(FATAL);
+    }
+    strcpy(entry->name, name);
+    name_map_put(&baseline->index, entry->name, baseline->count);
+    return &baseline->entries[baseline->count++];
+}
+
+static void baseline_load(BenchmarkBaseline *baseline, const char *path)
+{
+    memset(baseline, 0, sizeof(BenchmarkBaseline));
+    baseline->path = path;
+    char *text = path != NULL ? read_text_file(path, false) : NULL;
+    if (text == NULL)
+    {
+        return;
+    }
+    for (char *line = strtok(text, "\n"); line != NULL; line = strtok(NULL, "\n"))
+    {
+        char *separator = strchr(line, '\t');
+        if (separator == NULL)
+        {
+            continue;
+        }
+        *separator = '\0';
+        char *end = NULL;
+        unsigned long count = strtoul(separator + 1, &end, 10);
+        BaselineEntry *entry = baseline_entry(baseline, line);
+        entry->count = 0;
+        while (entry->count < count && entry->count < YACU_BENCHMARK_MAX_REPETITIONS && *end == '\t')
+        {
+            entry->samples[entry->count++] = strtod(end + 1, &end);
+        }
+    }
+    free(text);
+}
+
+static void baseline_free(BenchmarkBaseline *baseline)
+{
+    for (size_t i = 0; i < baseline->count; i++)
+    {
+        free(baseline->entries[i].name);
+    }
+    free(baseline->entries);
+    free(baseline->index.slots);
+    arena_free(&baseline->qualifiedName);
+}
+
+static void baseline_report_action(YacuReportState state, YacuReportEvent reportEvent, const YacuSuite *suite, const YacuTestRun *testRun)
+{
+    BenchmarkBaseline *baseline = state;
+    if (reportEvent == TEST_RUN_FINISHED && suite != NULL && testRun->benchmark.repetitions > 0)
+    {
+        BaselineEntry *entry = baseline_entry(baseline, qualified_case_name(&baseline->qualifiedName, suite, testRun->test, testRun->caseIndex, testRun->inputName));
+        entry->count = testRun->benchmark.repetitions;
+        memcpy(entry->samples, testRun->benchmark.samples, entry->count * sizeof(double));
+    }
+    else if (reportEvent == TESTING_FINISHED)
+    {
+        FILE *file = fopen(baseline->path, "w");
+        if (file == NULL)
+        {
+            exit(FILE_FAIL);
+        }
+        for (size_t i = 0; i < baseline->count; i++)
+        {
+            fprintf(file, "%s\t%zu", baseline->entries[i].name, baseline->entries[i].count);
+            for (size_t j = 0; j < baseline->entries[i].count; j++)
+            {
+                fprintf(file, "\t%.17g", baseline->entries[i].samples[j]);
+            }
+            fprintf(file, "\n");
+        }
+        fclose(file);
+    }
+}
+
+typedef struct RankedSample
+{
+    double value;
+    bool current;
+} RankedSample;
+
+static int compare_ranked_samples(const void *left, const void *right)
+{
+    return compare_doubles(&((const RankedSample *)left)->value, &((const RankedSample *)right)->value);
+}
+
+// Two-sided Mann-Whitney U test with the normal approximation, corrected
+// for ties and continuity.
+static double mann_whitney_p_value(const double *current, size_t currentCount, const double *previous, size_t previousCount)
+{
+    size_t total = currentCount + previousCount;
+    RankedSample ranked[2 * YACU_BENCHMARK_MAX_REPETITIONS];
+    for (size_t i = 0; i < total; i++)
+    {
+        ranked[i].current = i < currentCount;
+        ranked[i].value = i < currentCount ? current[i] : previous[i - currentCount];
+    }
+    qsort(ranked, total, sizeof(RankedSample), compare_ranked_samples);
+    double currentRanks = 0.0;
+    double ties = 0.0;
+    for (size_t first = 0; first < total;)
+    {
+        size_t last = first;
+        while (last + 1 < total && ranked[last + 1].value == ranked[first].value)
+        {
+            last++;
+        }
+        double rank = 0.5 * (double)(first + last) + 1.0;
+        double tied = (double)(last - first + 1);
+        ties += tied * tied * tied - tied;
+        for (size_t i = first; i <= last; i++)
+        {
+            currentRanks += ranked[i].current ? rank : 0.0;
+        }
+        first = last + 1;
+    }
+    double n1 = (double)currentCount;
+    double n2 = (double)previousCount;
+    double n = (double)total;
+    double u = currentRanks - n1 * (n1 + 1.0) / 2.0;
+    double variance = n1 * n2 / 12.0 * ((n + 1.0) - ties / (n * (n - 1.0)));
+    if (variance <= 0.0)
+    {
+        return 1.0;
+    }
+    double distance = fabs(u - n1 * n2 / 2.0) - 0.5;
+    double z = (distance > 0.0 ? distance : 0.0) / sqrt(variance);
+    return erfc(z / sqrt(2.0));
+}
+
+static void benchmark_compare(YacuTestRun *testRun, const YacuOptions *options)
+{
+    YacuBenchmarkStats *stats = &testRun->benchmark;
+    if (activeBaseline == NULL || testRun->suite == NULL || stats->repetitions < 2)
+    {
+        return;
+    }
+    const NameSlot *slot = name_map_find(&activeBaseline->index, qualified_case_name(&activeBaseline->qualifiedName, testRun->suite, testRun->test, testRun->caseIndex, testRun->inputName));
+    const BaselineEntry *entry = slot != NULL ? &activeBaseline->entries[slot->value] : NULL;
+    if (entry == NULL || entry->count < 2)
+    {
+        return;
+    }
+    YacuBenchmarkStats previous = {.repetitions = entry->count};
+    memcpy(previous.samples, entry->samples, entry->count * sizeof(double));
+    benchmark_statistics(&previous);
+    stats->baselineMedian = previous.median;
+    stats->change = previous.median > 0.0 ? stats->median / previous.median - 1.0 : 0.0;
+    stats->pValue = mann_whitney_p_value(stats->samples, stats->repetitions, entry->samples, entry->count);
+    if (stats->pValue >= YACU_BENCHMARK_ALPHA || fabs(stats->change) <= options->regressionThreshold)
+    {
+        return;
+    }
+    if (testRun->messageLength > 0)
+    {
+        test_run_message_append(testRun, "\n");
+    }
+    if (stats->change > 0.0)
+    {
+        testRun->result = TEST_FAILURE;
+        test_run_message_append(testRun, "Benchmark regressed: median %.2f ns/op, baseline %.2f ns/op (%+.1f%%, p=%.4f)",
+                                stats->median, previous.median, 100.0 * stats->change, stats->pValue);
+    }
+    else
+    {
+        test_run_message_append(testRun, "Benchmark improved: median %.2f ns/op, baseline %.2f ns/op (%+.1f%%, p=%.4f); refresh the baseline",
+                                stats->median, previous.median, 100.0 * stats->change, stats->pValue);
+    }
+}
+
+static void run_benchmark(YacuTestRun *testRun, YacuBenchmarkFcn benchmark, const YacuOptions *options)
+{
+    YacuBenchmarkStats *stats = &testRun->benchmark;
+    size_t iterations = benchmark_calibrate(testRun, benchmark, options->benchmarkTime);
+    for (size_t i = 0; i < options->benchmarkWarmups; i++)
+    {
+        benchmark_repetition(testRun, benchmark, iterations);
+    }
+    size_t repetitions = options->benchmarkRepetitions;
+    repetitions = repetitions < 1 ? 1 : repetitions;
+    repetitions = repetitions > YACU_BENCHMARK_MAX_REPETITIONS ? YACU_BENCHMARK_MAX_REPETITIONS : repetitions;
+    if (options->perfCounters)
+    {
+        perf_start();
+    }
+    for (size_t i = 0; i < repetitions; i++)
+    {
+        stats->samples[i] = 1e9 * benchmark_repetition(testRun, benchmark, iterations) / (double)iterations;
+    }
+    if (options->perfCounters)
+    {
+        perf_stop(&testRun->perf, (double)(repetitions * iterations));
+    }
+    stats->iterations = iterations;
+    stats->repetitions = repetitions;
+    benchmark_statistics(stats);
+}
+
+#ifdef FORK_AVAILABLE
+#define YACU_SETJMP(buffer) sigsetjmp(buffer, 1)
+#define YACU_LONGJMP(buffer) siglongjmp(buffer, 1)
+#else
+#define YACU_SETJMP(buffer) setjmp(buffer)
+#define YACU_LONGJMP(buffer) longjmp(buffer, 1)
+#endif
+
+typedef struct PlannedTest
+{
+    const YacuSuite *suite;
+    const YacuTest *test;
+    size_t caseIndex;
+} PlannedTest;
+
+static bool run_hook(YacuTestRun *testRun, YacuFixtureFcn hook)
+{
+    YacuJumpBuffer abortJump;
+    testRun->abortJump = &abortJump;
+    bool completed = false;
+    if (YACU_SETJMP(abortJump) == 0)
+    {
+        hook(testRun);
+        completed = testRun->result == OK;
+    }
+    testRun->abortJump = NULL;
+    return completed;
+}
+
+// Suite fixtures are built by the first test of the suite that a process
+// runs and are reused by its later tests. Workers keep them until they
+// exit; a serial run tears a suite's fixture down when the next suite
+// starts. With --isolated the pool process builds them before forking, so
+// every test process inherits them and only the pool tears them down.
+typedef struct SuiteFixture
+{
+    const YacuSuite *suite;
+    void *fixture;
+} SuiteFixture;
+
+typedef struct FixtureCache
+{
+    SuiteFixture *entries;
+    size_t count;
+    size_t capacity;
+    bool keep;
+} FixtureCache;
+
+static void fixtures_release(FixtureCache *fixtures, const void *runData)
+{
+    for (size_t i = 0; i < fixtures->count; i++)
+    {
+        const YacuSuite *suite = fixtures->entries[i].suite;
+        if (suite->teardown == NULL)
+        {
+            continue;
+        }
+        YacuMessageArena arena = {NULL, 0, 0};
+        YacuTestRun teardownRun = {.result = OK, .message = "", .arena = &arena, .runData = runData, .globalState = activeGlobalState,
+                                   .fixture = fixtures->entries[i].fixture, .suite = suite};
+        if (!run_hook(&teardownRun, suite->teardown))
+        {
+            fprintf(stderr, "Teardown of suite %s failed: %s\n", suite->name, teardownRun.message);
+        }
+        arena_free(&arena);
+    }
+    fixtures->count = 0;
+}
+
+static void fixtures_free(FixtureCache *fixtures, const void *runData)
+{
+    if (fixtures != NULL)
+    {
+        fixtures_release(fixtures, runData);
+        free(fixtures->entries);
+    }
+}
+
+static bool fixture_acquire(FixtureCache *fixtures, YacuTestRun *testRun)
+{
+    const YacuSuite *suite = testRun->suite;
+    if (fixtures == NULL || (suite->setup == NULL && suite->teardown == NULL))
+    {
+        return true;
+    }
+    for (size_t i = 0; i < fixtures->count; i++)
+    {
+        if (fixtures->entries[i].suite == suite)
+        {
+            testRun->fixture = fixtures->entries[i].fixture;
+            return true;
+        }
+    }
+    if (!fixtures->keep)
+    {
+        fixtures_release(fixtures, testRun->runData);
+    }
+    if (suite->setup != NULL && !run_hook(testRun, suite->setup))
+    {
+        return false;
+    }
+    if (fixtures->count == fixtures->capacity)
+    {
+        fixtures->capacity = fixtures->capacity == 0 ? 8 : 2 * fixtures->capacity;
+        fixtures->entries = realloc(fixtures->entries, fixtures->capacity * sizeof(SuiteFixture));
+        if (fixtures->entries == NULL)
+        {
+            exit(FATAL);
+        }
+    }
+    SuiteFixture entry = {suite, testRun->fixture};
+    fixtures->entries[fixtures->count++] = entry;
+    return true;
+}
+
+static int compare_names(const void *left, const void *right)
+{
+    return strcmp(*(char *const *)left, *(char *const *)right);
+}
+
+static void corpus_load(Corpus *corpus, const char *directory)
+{
+    memset(corpus, 0, sizeof(Corpus));
+    corpus->directory = directory;
+    if (directory == NULL)
+    {
+        return;
+    }
+#ifdef FORK_AVAILABLE
+    DIR *dir = opendir(directory);
+    if (dir == NULL)
+    {
+        exit(FILE_FAIL);
+    }
+    size_t capacity = 0;
+    for (struct dirent *entry = readdir(dir); entry != NULL; entry = readdir(dir))
+    {
+        struct stat status;
+        if (entry->d_name[0] == '.' || fstatat(dirfd(dir), entry->d_name, &status, 0) != 0 || !S_ISREG(status.st_mode))
+        {
+            continue;
+        }
+        if (corpus->count == capacity)
+        {
+            capacity = capacity == 0 ? 64 : 2 * capacity;
+            corpus->names = realloc(corpus->names, capacity * sizeof(char *));
+        }
+        size_t size = strlen(entry->d_name) + 2;
+        char *name = malloc(size);
+        if (corpus->names == NULL || name == NULL)
+        {
+            exit(FATAL);
+        }
+        snprintf(name, size, "/%s", entry->d_name);
+        corpus->names[corpus->count++] = name;
+    }
+    closedir(dir);
+    if (corpus->count > 0)
+    {
+        qsort(corpus->names, corpus->count, sizeof(char *), compare_names);
+    }
+#else
+    exit(FILE_FAIL);
+#endif
+}
+
+static void corpus_free(Corpus *corpus)
+{
+    for (size_t i = 0; i < corpus->count; i++)
+    {
+        free(corpus->names[i]);
+    }
+    free(corpus->names);
+}
+
+// An input is mapped read-only while its case runs; without a corpus the
+// target gets an empty input.
+typedef struct FuzzInput
+{
+    const uint8_t *data;
+    size_t size;
+    void *mapping;
+} FuzzInput;
+
+static bool fuzz_input_map(FuzzInput *input, size_t caseIndex)
+{
+    static const uint8_t empty[1] = {0};
+    input->data = empty;
+    input->size = 0;
+    input->mapping = NULL;
+    if (activeCorpus == NULL)
+    {
+        return true;
+    }
+#ifdef FORK_AVAILABLE
+    size_t size = strlen(activeCorpus->directory) + strlen(activeCorpus->names[caseIndex]) + 1;
+    char *path = malloc(size);
+    if (path == NULL)
+    {
+        exit(FATAL);
+    }
+    snprintf(path, size, "%s%s", activeCorpus->directory, activeCorpus->names[caseIndex]);
+    int fd = open(path, O_RDONLY);
+    free(path);
+    struct stat status;
+    if (fd < 0 || fstat(fd, &status) != 0)
+    {
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+        return false;
+    }
+    if (status.st_size > 0)
+    {
+        input->mapping = mmap(NULL, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (input->mapping == MAP_FAILED)
+        {
+            input->mapping = NULL;
+            close(fd);
+            return false;
+        }
+        input->data = input->mapping;
+        input->size = (size_t)status.st_size;
+    }
+    close(fd);
+    return true;
+#else
+    UNUSED(caseIndex);
+    return false;
+#endif
+}
+
+static void fuzz_input_unmap(FuzzInput *input)
+{
+#ifdef FORK_AVAILABLE
+    if (input->mapping != NULL)
+    {
+        munmap(input->mapping, input->size);
+    }
+#endif
+    input->mapping = NULL;
+}
+
+static void run_fuzz_target(YacuTestRun *testRun)
+{
+    const FuzzInput *input = testRun->testCase;
+    int returned = testRun->test->fuzz(input->data, input->size);
+    yacu_assert(testRun, returned == 0 || returned == -1, "Fuzz target returned %d on a %zu byte input", returned, input->size);
+}
+
+static void run_guarded(YacuTestRun *testRun, const YacuOptions *options)
+{
+    YacuJumpBuffer abortJump;
+    testRun->abortJump = &abortJump;
+    YacuAllocStats *outerAllocs = yacuActiveAllocs;
+    yacuActiveAllocs = &testRun->allocs;
+    bool countTest = options->perfCounters && testRun->test->benchmark == NULL;
+    volatile bool setUp = false;
+    // Counters cover the test body only, not its setup and teardown.
+    volatile bool counting = false;
+    if (YACU_SETJMP(abortJump) == 0)
+    {
+        if (testRun->test->setup != NULL)
+        {
+            testRun->test->setup(testRun);
+        }
+        setUp = true;
+        if (countTest)
+        {
+            counting = true;
+            perf_start();
+        }
+        if (testRun->test->benchmark != NULL)
+        {
+            run_benchmark(testRun, testRun->test->benchmark, options);
+        }
+        else if (testRun->test->fuzz != NULL)
+        {
+            run_fuzz_target(testRun);
+        }
+        else
+        {
+            testRun->test->fcn(testRun);
+        }
+    }
+    if (counting)
+    {
+        perf_stop(&testRun->perf, 1.0);
+    }
+    if (setUp && testRun->test->teardown != NULL && YACU_SETJMP(abortJump) == 0)
+    {
+        testRun->test->teardown(testRun);
+    }
+    yacuActiveAllocs = outerAllocs;
+    testRun->abortJump = NULL;
+    if (testRun->test->benchmark != NULL)
+    {
+        benchmark_compare(testRun, options);
+    }
+    YacuAllocStats *allocs = &testRun->allocs;
+    allocs->leakedBytes = allocs->allocatedBytes > allocs->freedBytes ? allocs->allocatedBytes - allocs->freedBytes : 0;
+}
+
+// Reports see the table entry of a case; generated cases only live while
+// the test runs.
+static const void *case_data(const YacuTest *test, size_t caseIndex)
+{
+    return test->cases != NULL && caseIndex < test->caseCount ? (const char *)test->cases + caseIndex * test->caseSize : NULL;
+}
+
+// A property case is the sequence of choices its draws make, each a number
+// up to a bound with 0 the simplest. Random choices come from a splitmix64
+// generator seeded per case; shrinking replays simpler sequences, and a
+// replay past the end of its sequence draws zeros.
+typedef struct YacuProperty
+{
+    uint64_t state;
+    uint64_t *choices;
+    size_t count;
+    size_t capacity;
+    const uint64_t *replay;
+    size_t replayCount;
+    YacuMessageArena *drawn;
+} YacuProperty;
+
+#define PROPERTY_DOUBLE_STEPS (UINT64_C(1) << 53)
+
+static const char propertyAlphabet[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789 !\"#$%&'()*+,-./:;<=>?@[\\]^_`{|}~";
+
+static uint64_t property_mix(uint64_t value)
+{
+    value = (value ^ (value >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+    value = (value ^ (value >> 27)) * UINT64_C(0x94D049BB133111EB);
+    return value ^ (value >> 31);
+}
+
+static uint64_t property_random(YacuProperty *property)
+{
+    property->state += UINT64_C(0x9E3779B97F4A7C15);
+    return property_mix(property->state);
+}
+
+static YacuProperty *property_of(YacuTestRun *testRun)
+{
+    yacu_assert(testRun, testRun->property != NULL, "%s - yacu_draw_* needs a property test", testRun->test->name);
+    return testRun->property;
+}
+
+// Random choices take either end of their range one time in eight, as
+// that is where edge cases live.
+static uint64_t property_random_choice(YacuProperty *property, uint64_t bound)
+{
+    uint64_t pick = property_random(property) & 15;
+    uint64_t random = property_random(property);
+    return pick == 0 ? 0 : pick == 1 ? bound : bound == UINT64_MAX ? random : random % (bound + 1);
+}
+
+// Records the generated choice, or the replayed one while shrinking.
+static uint64_t property_record(YacuProperty *property, uint64_t bound, uint64_t generated)
+{
+    uint64_t choice = generated;
+    if (property->replay != NULL)
+    {
+        choice = property->count < property->replayCount ? property->replay[property->count] : 0;
+        choice = choice < bound ? choice : bound;
+    }
+    if (property->count == property->capacity)
+    {
+        YacuAllocStats *activeAllocs = yacuActiveAllocs;
+        yacuActiveAllocs = NULL;
+        property->capacity = property->capacity == 0 ? 64 : 2 * property->capacity;
+        property->choices = realloc(property->choices, property->capacity * sizeof(uint64_t));
+        yacuActiveAllocs = activeAllocs;
+        if (property->choices == NULL)
+        {
+            exit(FATAL);
+        }
+    }
+    property->choices[property->count++] = choice;
+    return choice;
+}
+
+static uint64_t property_choice(YacuTestRun *testRun, uint64_t bound)
+{
+    YacuProperty *property = property_of(testRun);
+    return property_record(property, bound, property->replay == NULL ? property_random_choice(property, bound) : 0);
+}
+
+// Bytes and strings go on with another element while a choice is 1, so
+// deleting an element together with its choice shortens them.
+static size_t property_length(YacuTestRun *testRun, size_t maxLength)
+{
+    YacuProperty *property = property_of(testRun);
+    return property->replay == NULL ? (size_t)property_random_choice(property, maxLength) : 0;
+}
+
+static bool property_more(YacuTestRun *testRun, size_t length, size_t target, size_t maxLength)
+{
+    return length < maxLength && property_record(testRun->property, 1, length < target) == 1;
+}
+
+// Draws are written down only while the shrunk case is replayed for the
+// message; each one starts a new comma separated item.
+static void property_describe(YacuTestRun *testRun, bool item, const char *format, ...)
+{
+    YacuMessageArena *drawn = testRun->property->drawn;
+    if (drawn == NULL)
+    {
+        return;
+    }
+    YacuAllocStats *activeAllocs = yacuActiveAllocs;
+    yacuActiveAllocs = NULL;
+    if (item && drawn->length > 0)
+    {
+        arena_reserve(drawn, 2);
+        memcpy(drawn->data + drawn->length, ", ", 3);
+        drawn->length += 2;
+    }
+    va_list args;
+    va_start(args, format);
+    arena_vappend(drawn, format, args);
+    va_end(args);
+    yacuActiveAllocs = activeAllocs;
+}
+
+int64_t yacu_draw_int(YacuTestRun *testRun, int64_t min, int64_t max)
+{
+    yacu_assert(testRun, min <= max, "yacu_draw_int range [%lld, %lld] is empty", (long long)min, (long long)max);
+    int64_t value = 0;
+    if (min > 0)
+    {
+        value = min + (int64_t)property_choice(testRun, (uint64_t)max - (uint64_t)min);
+    }
+    else if (max < 0)
+    {
+        value = max - (int64_t)property_choice(testRun, (uint64_t)max - (uint64_t)min);
+    }
+    else
+    {
+        bool negative = min < 0 && (max == 0 || property_choice(testRun, 1) == 1);
+        uint64_t magnitude = property_choice(testRun, negative ? (uint64_t)(-(min + 1)) + 1 : (uint64_t)max);
+        value = !negative ? (int64_t)magnitude : magnitude == 0 ? 0 : -1 - (int64_t)(magnitude - 1);
+    }
+    property_describe(testRun, true, "%lld", (long long)value);
+    return value;
+}
+
+double yacu_draw_double(YacuTestRun *testRun, double min, double max)
+{
+    yacu_assert(testRun, isfinite(min) && isfinite(max) && min <= max, "yacu_draw_double range [%g, %g] is not finite", min, max);
+    double origin = min > 0.0 ? min : max < 0.0 ? max : 0.0;
+    bool negative = min < origin && (max == origin || property_choice(testRun, 1) == 1);
+    double span = negative ? origin - min : max - origin;
+    double fraction = (double)property_choice(testRun, PROPERTY_DOUBLE_STEPS) / (double)PROPERTY_DOUBLE_STEPS;
+    double value = negative ? origin - span * fraction : origin + span * fraction;
+    value = value < min ? min : value > max ? max : value;
+    property_describe(testRun, true, "%.17g", value);
+    return value;
+}
+
+size_t yacu_draw_bytes(YacuTestRun *testRun, uint8_t *buffer, size_t maxSize)
+{
+    size_t target = property_length(testRun, maxSize);
+    size_t size = 0;
+    while (property_more(testRun, size, target, maxSize))
+    {
+        buffer[size++] = (uint8_t)property_choice(testRun, UINT8_MAX);
+    }
+    property_describe(testRun, true, "{");
+    for (size_t i = 0; i < size; i++)
+    {
+        property_describe(testRun, false, i == 0 ? "%02x" : " %02x", buffer[i]);
+    }
+    property_describe(testRun, false, "}");
+    return size;
+}
+
+size_t yacu_draw_string(YacuTestRun *testRun, char *buffer, size_t maxLength, const char *alphabet)
+{
+    alphabet = alphabet != NULL ? alphabet : propertyAlphabet;
+    size_t letters = strlen(alphabet);
+    yacu_assert(testRun, letters > 0, "yacu_draw_string alphabet is empty");
+    size_t target = property_length(testRun, maxLength);
+    size_t length = 0;
+    while (property_more(testRun, length, target, maxLength))
+    {
+        buffer[length++] = alphabet[property_choice(testRun, letters - 1)];
+    }
+    buffer[length] = '\0';
+    property_describe(testRun, true, "\"");
+    for (size_t i = 0; i < length; i++)
+    {
+        unsigned char letter = (unsigned char)buffer[i];
+        if (letter == '"' || letter == '\\')
+        {
+            property_describe(testRun, false, "\\%c", letter);
+        }
+        else if (letter < ' ' || letter > '~')
+        {
+            property_describe(testRun, false, "\\x%02x", letter);
+        }
+        else
+        {
+            property_describe(testRun, false, "%c", letter);
+        }
+    }
+    property_describe(testRun, false, "\"");
+    return length;
+}
+
+static size_t property_cases(const YacuTest *test, const YacuOptions *options)
+{
+    return options->propertyCases > 0 ? options->propertyCases : test->propertyCases;
+}
+
+static size_t planned_cases(const YacuTest *test, const YacuOptions *options)
+{
+    if (test->fuzz != NULL)
+    {
+        return activeCorpus != NULL ? activeCorpus->count : 1;
+    }
+    if (test->propertyCases > 0)
+    {
+        return (property_cases(test, options) + YACU_PROPERTY_BATCH_SIZE - 1) / YACU_PROPERTY_BATCH_SIZE;
+    }
+    return test->caseCount > 0 ? test->caseCount : 1;
+}
+
+static void property_restart(YacuTestRun *testRun, const uint64_t *replay, size_t replayCount)
+{
+    arena_reset(testRun->arena);
+    testRun->result = OK;
+    testRun->message = "";
+    testRun->messageLength = 0;
+    testRun->property->count = 0;
+    testRun->property->replay = replay;
+    testRun->property->replayCount = replayCount;
+}
+
+// Shrinking only accepts sequences that are shorter, or as long and
+// lexicographically smaller, so it always terminates.
+static bool choices_simpler(const uint64_t *left, size_t leftCount, const uint64_t *right, size_t rightCount)
+{
+    if (leftCount != rightCount)
+    {
+        return leftCount < rightCount;
+    }
+    for (size_t i = 0; i < leftCount; i++)
+    {
+        if (left[i] != right[i])
+        {
+            return left[i] < right[i];
+        }
+    }
+    return false;
+}
+
+typedef struct PropertyShrink
+{
+    uint64_t *best;
+    size_t count;
+    uint64_t *candidate;
+    size_t runs;
+    size_t shrinks;
+} PropertyShrink;
+
+static bool shrink_attempt(YacuTestRun *testRun, const YacuOptions *options, PropertyShrink *shrink, size_t candidateCount)
+{
+    if (shrink->runs >= YACU_PROPERTY_SHRINK_LIMIT)
+    {
+        return false;
+    }
+    shrink->runs++;
+    YacuProperty *property = testRun->property;
+    property_restart(testRun, shrink->candidate, candidateCount);
+    run_guarded(testRun, options);
+    if (testRun->result == OK || !choices_simpler(property->choices, property->count, shrink->best, shrink->count))
+    {
+        return false;
+    }
+    memcpy(shrink->best, property->choices, property->count * sizeof(uint64_t));
+    shrink->count = property->count;
+    shrink->shrinks++;
+    return true;
+}
+
+// Deletes blocks of choices, then lowers each choice to 0 or by bisection,
+// until a whole pass finds nothing simpler that still fails.
+static void property_shrink(YacuTestRun *testRun, const YacuOptions *options, PropertyShrink *shrink)
+{
+    bool improved = true;
+    while (improved && shrink->runs < YACU_PROPERTY_SHRINK_LIMIT)
+    {
+        improved = false;
+        for (size_t block = 8; block > 0; block /= 2)
+        {
+            for (size_t i = 0; i + block <= shrink->count;)
+            {
+                memcpy(shrink->candidate, shrink->best, i * sizeof(uint64_t));
+                memcpy(shrink->candidate + i, shrink->best + i + block, (shrink->count - i - block) * sizeof(uint64_t));
+                if (shrink_attempt(testRun, options, shrink, shrink->count - block))
+                {
+                    improved = true;
+                }
+                else
+                {
+                    i++;
+                }
+            }
+        }
+        for (size_t i = 0; i < shrink->count; i++)
+        {
+            uint64_t low = 0;
+            while (i < shrink->count && shrink->best[i] > low)
+            {
+                uint64_t middle = shrink->best[i] - low > 1 ? low + (shrink->best[i] - low) / 2 : low;
+                memcpy(shrink->candidate, shrink->best, shrink->count * sizeof(uint64_t));
+                shrink->candidate[i] = middle;
+                if (shrink_attempt(testRun, options, shrink, shrink->count))
+                {
+                    improved = true;
+                }
+                else if (middle == low)
+                {
+                    break;
+                }
+                else
+                {
+                    low = middle;
+                }
+            }
+        }
+    }
+}
+
+// Replays the shrunk case once more so that the message describes it.
+static void property_report(YacuTestRun *testRun, const YacuOptions *options, const PropertyShrink *shrink, size_t caseNumber)
+{
+    YacuMessageArena drawn = {NULL, 0, 0};
+    testRun->property->drawn = &drawn;
+    property_restart(testRun, shrink->best, shrink->count);
+    run_guarded(testRun, options);
+    testRun->property->drawn = NULL;
+    if (testRun->result == OK)
+    {
+        testRun->result = TEST_FAILURE;
+        test_run_message_append(testRun, "Property case %zu of --seed %llu failed but passed when replayed", caseNumber,
+                                (unsigned long long)options->propertySeed);
+    }
+    else
+    {
+        test_run_message_append(testRun, "\nFalsified by case %zu of --seed %llu after %zu shrinks: %s", caseNumber,
+                                (unsigned long long)options->propertySeed, shrink->shrinks, drawn.length > 0 ? drawn.data : "no draws");
+    }
+    arena_free(&drawn);
+}
+
+static void run_property(YacuTestRun *testRun, const YacuOptions *options)
+{
+    size_t cases = property_cases(testRun->test, options);
+    size_t first = testRun->caseIndex * YACU_PROPERTY_BATCH_SIZE;
+    size_t last = cases - first > YACU_PROPERTY_BATCH_SIZE ? first + YACU_PROPERTY_BATCH_SIZE : cases;
+    YacuProperty property = {0};
+    testRun->property = &property;
+    for (size_t caseNumber = first; caseNumber < last; caseNumber++)
+    {
+        property_restart(testRun, NULL, 0);
+        property.state = property_mix(options->propertySeed ^ property_mix(caseNumber + 1));
+        run_guarded(testRun, options);
+        if (testRun->result == OK)
+        {
+            continue;
+        }
+        PropertyShrink shrink = {malloc((property.count + 1) * sizeof(uint64_t)), property.count, malloc((property.count + 1) * sizeof(uint64_t)), 0, 0};
+        if (shrink.best == NULL || shrink.candidate == NULL)
+        {
+            exit(FATAL);
+        }
+        memcpy(shrink.best, property.choices, property.count * sizeof(uint64_t));
+        property_shrink(testRun, options, &shrink);
+        property_report(testRun, options, &shrink, caseNumber);
+        free(shrink.best);
+        free(shrink.candidate);
+        break;
+    }
+    free(property.choices);
+    testRun->property = NULL;
+}
+
+static YacuStatus yacu_run_test(const PlannedTest *planned, YacuReportPtr *reports, const YacuOptions *options, RunReporter *reporter, YacuMessageArena *arena, FixtureCache *fixtures)
+{
+    const YacuSuite *suite = planned->suite;
+    const YacuTest *test = planned->test;
+    arena_reset(arena);
+    YacuTestRun testRun = {.result = OK, .message = "", .arena = arena, .reports = reports, .runData = options->runData, .globalState = activeGlobalState,
+                           .testCase = case_data(test, planned->caseIndex), .caseIndex = planned->caseIndex,
+                           .inputName = corpus_input_name(test, planned->caseIndex), .test = test, .suite = suite};
+    on_test_started(reports, suite, &testRun);
+    bool fixtureReady = fixture_acquire(fixtures, &testRun);
+    void *generated = NULL;
+    if (fixtureReady && test->generate != NULL)
+    {
+        generated = calloc(1, test->caseSize > 0 ? test->caseSize : 1);
+        if (generated == NULL)
+        {
+            exit(FATAL);
+        }
+        test->generate(planned->caseIndex, generated, options->runData);
+        testRun.testCase = generated;
+    }
+    FuzzInput input = {NULL, 0, NULL};
+    if (fixtureReady && test->fuzz != NULL)
+    {
+        if (!fuzz_input_map(&input, planned->caseIndex))
+        {
+            testRun.result = FILE_FAIL;
+            test_run_message_append(&testRun, "Cannot read corpus input %s%s", activeCorpus->directory, activeCorpus->names[planned->caseIndex]);
+            fixtureReady = false;
+        }
+        testRun.testCase = &input;
+    }
+    start_timing(&testRun);
+    if (fixtureReady && test->propertyCases > 0)
+    {
+        run_property(&testRun, options);
+    }
+    else if (fixtureReady)
+    {
+        run_guarded(&testRun, options);
+    }
+    stop_timing(&testRun);
+    testRun.testCase = case_data(test, planned->caseIndex);
+    free(generated);
+    fuzz_input_unmap(&input);
+    if (reporter != NULL)
+    {
+        reporter_record(reporter, &testRun);
+    }
+    on_test_finished(reports, suite, &testRun);
+    return testRun.result;
+}
+
+static void record_failure(YacuTestRun *testRun, const char *fmt, va_list args)
+{
+    YacuAllocStats *activeAllocs = yacuActiveAllocs;
+    yacuActiveAllocs = NULL;
+    testRun->result = TEST_FAILURE;
+    if (testRun->messageLength > 0)
+    {
+        test_run_message_append(testRun, "\n");
+    }
+    test_run_message_vappend(testRun, fmt, args);
+    yacuActiveAllocs = activeAllocs;
+}
+
+void yacu_assert(YacuTestRun *testRun, bool condition, const char *fmt, ...)
+{
+    if (!(condition))
+    {
+        va_list args;
+        va_start(args, fmt);
+        record_failure(testRun, fmt, args);
+        va_end(args);
+        if (testRun->abortJump != NULL)
+        {
+            YACU_LONGJMP(*testRun->abortJump);
+        }
+        stop_timing(testRun);
+        on_test_finished(testRun->reports, testRun->suite, testRun);
+        on_suite_finished(testRun->reports, testRun->suite, NULL);
+        on_testing_finished(testRun->reports, NULL);
+        exit(TEST_FAILURE);
+    }
+}
+
+void yacu_expect(YacuTestRun *testRun, bool condition, const char *fmt, ...)
+{
+    if (!(condition))
+    {
+        va_list args;
+        va_start(args, fmt);
+        record_failure(testRun, fmt, args);
+        va_end(args);
+    }
+}
+
+// Array checks skip equal stretches a vector at a time and compare the
+// elements of a block one by one only where a vector differed.
+#define ARRAY_SCALAR_BLOCK 32
+#define ARRAY_DETAIL_SIZE 96
+
+#ifdef YACU_X86_SIMD
+static bool array_avx2()
+{
+    static int available = -1;
+    if (available < 0)
+    {
+        available = __builtin_cpu_supports("avx2") ? 1 : 0;
+    }
+    return available == 1;
+}
+
+__attribute__((target("avx2"))) static size_t skip_equal_bytes_avx2(const uint8_t *left, const uint8_t *right, size_t start, size_t size)
+{
+    for (; start + 32 <= size; start += 32)
+    {
+        __m256i equal = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(left + start)), _mm256_loadu_si256((const __m256i *)(right + start)));
+        if ((unsigned)_mm256_movemask_epi8(equal) != 0xFFFFFFFFu)
+        {
+            break;
+        }
+    }
+    return start;
+}
+
+__attribute__((target("avx2"))) static size_t skip_close_doubles_avx2(const double *left, const double *right, size_t start, size_t count, double absolute, double relative)
+{
+    __m256d sign = _mm256_set1_pd(-0.0);
+    __m256d absoluteTolerance = _mm256_set1_pd(absolute);
+    __m256d relativeTolerance = _mm256_set1_pd(relative);
+    for (; start + 4 <= count; start += 4)
+    {
+        __m256d leftValues = _mm256_loadu_pd(left + start);
+        __m256d rightValues = _mm256_loadu_pd(right + start);
+        __m256d error = _mm256_andnot_pd(sign, _mm256_sub_pd(leftValues, rightValues));
+        __m256d scale = _mm256_max_pd(_mm256_andnot_pd(sign, leftValues), _mm256_andnot_pd(sign, rightValues));
+        __m256d tolerance = _mm256_max_pd(absoluteTolerance, _mm256_mul_pd(relativeTolerance, scale));
+        if (_mm256_movemask_pd(_mm256_cmp_pd(error, tolerance, _CMP_LE_OQ)) != 0xF)
+        {
+            break;
+        }
+    }
+    return start;
+}
+#endif
+
+static size_t skip_equal_bytes(const uint8_t *left, const uint8_t *right, size_t start, size_t size)
+{
+#ifdef YACU_X86_SIMD
+    if (array_avx2())
+    {
+        return skip_equal_bytes_avx2(left, right, start, size);
+    }
+#endif
+#ifdef __SSE2__
+    for (; start + 16 <= size; start += 16)
+    {
+        __m128i equal = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(left + start)), _mm_loadu_si128((const __m128i *)(right + start)));
+        if (_mm_movemask_epi8(equal) != 0xFFFF)
+        {
+            break;
+        }
+    }
+#else
+    for (; start + 8 <= size; start += 8)
+    {
+        uint64_t leftWord;
+        uint64_t rightWord;
+        memcpy(&leftWord, left + start, sizeof(uint64_t));
+        memcpy(&rightWord, right + start, sizeof(uint64_t));
+        if (leftWord != rightWord)
+        {
+            break;
+        }
+    }
+#endif
+    return start;
+}
+
+// A pair is close when its error is within the larger of the absolute
+// tolerance and the relative one scaled by the larger magnitude.
+static size_t skip_close_doubles(const double *left, const double *right, size_t start, size_t count, double absolute, double relative)
+{
+#ifdef YACU_X86_SIMD
+    if (array_avx2())
+    {
+        return skip_close_doubles_avx2(left, right, start, count, absolute, relative);
+    }
+#endif
+#ifdef __SSE2__
+    __m128d sign = _mm_set1_pd(-0.0);
+    __m128d absoluteTolerance = _mm_set1_pd(absolute);
+    __m128d relativeTolerance = _mm_set1_pd(relative);
+    for (; start + 2 <= count; start += 2)
+    {
+        __m128d leftValues = _mm_loadu_pd(left + start);
+        __m128d rightValues = _mm_loadu_pd(right + start);
+        __m128d error = _mm_andnot_pd(sign, _mm_sub_pd(leftValues, rightValues));
+        __m128d scale = _mm_max_pd(_mm_andnot_pd(sign, leftValues), _mm_andnot_pd(sign, rightValues));
+        __m128d tolerance = _mm_max_pd(absoluteTolerance, _mm_mul_pd(relativeTolerance, scale));
+        if (_mm_movemask_pd(_mm_cmple_pd(error, tolerance)) != 0x3)
+        {
+            break;
+        }
+    }
+#else
+    UNUSED(left);
+    UNUSED(right);
+    UNUSED(count);
+    UNUSED(absolute);
+    UNUSED(relative);
+#endif
+    return start;
+}
+
+// Maps doubles to unsigned integers in the same order, so that the
+// distance of two keys counts the doubles between them.
+static uint64_t ulp_key(double value)
+{
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(uint64_t));
+    return (bits >> 63) != 0 ? ~bits : bits | (UINT64_C(1) << 63);
+}
+
+static bool doubles_close(double left, double right, double absolute, double relative, uint64_t ulps)
+{
+    if (left == right || (isnan(left) && isnan(right)))
+    {
+        return true;
+    }
+    if (isnan(left) || isnan(right))
+    {
+        return false;
+    }
+    double error = fabs(left - right);
+    if (error <= absolute || error <= relative * fmax(fabs(left), fabs(right)))
+    {
+        return true;
+    }
+    uint64_t leftKey = ulp_key(left);
+    uint64_t rightKey = ulp_key(right);
+    return (leftKey > rightKey ? leftKey - rightKey : rightKey - leftKey) <= ulps;
+}
+
+typedef struct ArrayMismatches
+{
+    size_t count;
+    size_t maxIndex;
+    double maxError;
+    size_t length;
+    char details[YACU_ARRAY_MISMATCHES * ARRAY_DETAIL_SIZE];
+} ArrayMismatches;
+
+static void array_mismatch(ArrayMismatches *mismatches, size_t index, double error, const char *format, ...)
+{
+    if (mismatches->count == 0 || error > mismatches->maxError)
+    {
+        mismatches->maxError = error;
+        mismatches->maxIndex = index;
+    }
+    if (mismatches->count++ < YACU_ARRAY_MISMATCHES)
+    {
+        size_t space = sizeof(mismatches->details) - mismatches->length;
+        int length = snprintf(mismatches->details + mismatches->length, space, mismatches->length == 0 ? " " : ", ");
+        mismatches->length += length < 0 ? 0 : (size_t)length < space ? (size_t)length : space - 1;
+        space = sizeof(mismatches->details) - mismatches->length;
+        va_list args;
+        va_start(args, format);
+        length = vsnprintf(mismatches->details + mismatches->length, space, format, args);
+        va_end(args);
+        mismatches->length += length < 0 ? 0 : (size_t)length < space ? (size_t)length : space - 1;
+    }
+}
+
+static void array_report(YacuCheckFcn check, YacuTestRun *testRun, const char *file, int line, const char *kind, const char *label,
+                         const ArrayMismatches *mismatches, size_t count, const char *unit)
+{
+    if (mismatches->count > 0)
+    {
+        check(testRun, false, "%s:%d - %s %s (%zu of %zu %s differ, max error %.17g at [%zu]:%s%s) failed!", file, line, kind, label,
+              mismatches->count, count, unit, mismatches->maxError, mismatches->maxIndex, mismatches->details,
+              mismatches->count > YACU_ARRAY_MISMATCHES ? " ..." : "");
+    }
+}
+
+void yacu_check_mem(YacuCheckFcn check, YacuTestRun *testRun, const char *file, int line, const char *kind, const char *label,
+                    const void *left, const void *right, size_t size)
+{
+    const uint8_t *leftBytes = left;
+    const uint8_t *rightBytes = right;
+    ArrayMismatches mismatches = {0};
+    for (size_t i = 0; i < size;)
+    {
+        i = skip_equal_bytes(leftBytes, rightBytes, i, size);
+        for (size_t end = size - i > ARRAY_SCALAR_BLOCK ? i + ARRAY_SCALAR_BLOCK : size; i < end; i++)
+        {
+            if (leftBytes[i] != rightBytes[i])
+            {
+                array_mismatch(&mismatches, i, fabs((double)leftBytes[i] - rightBytes[i]), "[%zu] %02x != %02x", i, leftBytes[i], rightBytes[i]);
+            }
+        }
+    }
+    array_report(check, testRun, file, line, kind, label, &mismatches, size, "bytes");
+}
+
+void yacu_check_array_int(YacuCheckFcn check, YacuTestRun *testRun, const char *file, int line, const char *kind, const char *label,
+                          const int *left, const int *right, size_t count)
+{
+    ArrayMismatches mismatches = {0};
+    for (size_t i = 0; i < count;)
+    {
+        i = skip_equal_bytes((const uint8_t *)left, (const uint8_t *)right, i * sizeof(int), count * sizeof(int)) / sizeof(int);
+        for (size_t end = count - i > ARRAY_SCALAR_BLOCK ? i + ARRAY_SCALAR_BLOCK : count; i < end; i++)
+        {
+            if (left[i] != right[i])
+            {
+                array_mismatch(&mismatches, i, fabs((double)left[i] - right[i]), "[%zu] %d != %d", i, left[i], right[i]);
+            }
+        }
+    }
+    array_report(check, testRun, file, line, kind, label, &mismatches, count, "elements");
+}
+
+void yacu_check_array_dbl(YacuCheckFcn check, YacuTestRun *testRun, const char *file, int line, const char *kind, const char *label,
+                          const double *left, const double *right, size_t count, double absolute, double relative, uint64_t ulps)
+{
+    ArrayMismatches mismatches = {0};
+    for (size_t i = 0; i < count;)
+    {
+        i = skip_close_doubles(left, right, i, count, absolute, relative);
+        for (size_t end = count - i > ARRAY_SCALAR_BLOCK ? i + ARRAY_SCALAR_BLOCK : count; i < end; i++)
+        {
+            if (!doubles_close(left[i], right[i], absolute, relative, ulps))
+            {
+                double error = fabs(left[i] - right[i]);
+                array_mismatch(&mismatches, i, isnan(error) ? INFINITY : error, "[%zu] %.17g != %.17g", i, left[i], right[i]);
+            }
+        }
+    }
+    array_report(check, testRun, file, line, kind, label, &mismatches, count, "elements");
+}
+
+static void junit_initialize(JUnitReport *current, const char *jUnitPath)
+{
+    current->file = NULL;
+    current->buffered = 0;
+    current->cursor = 0;
+    current->inSuite = false;
+    if (jUnitPath == NULL)
+    {
+        return;
+    }
+    current->file = fopen(jUnitPath, "w");
+    if (current->file == NULL)
+    {
+        exit(FILE_FAIL);
+    }
+    setvbuf(current->file, NULL, _IONBF, 0);
+    junit_write(current, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                         "<testsuites>\n");
+    junit_commit(current);
+}
+
+typedef struct TestPlan
+{
+    PlannedTest *tests;
+    size_t count;
+    // Leading tests that are dispatched before the rest.
+    size_t prioritized;
+} TestPlan;
+
+typedef struct PatternList
+{
+    const char **patterns;
+    size_t count;
+    size_t capacity;
+} PatternList;
+
+static void pattern_list_add(PatternList *list, const char *pattern)
+{
+    if (list->count == list->capacity)
+    {
+        list->capacity = list->capacity == 0 ? 8 : 2 * list->capacity;
+        list->patterns = realloc(list->patterns, list->capacity * sizeof(const char *));
+        if (list->patterns == NULL)
+        {
+            exit(FATAL);
+        }
+    }
+    list->patterns[list->count++] = pattern;
+}
+
+static bool glob_match(const char *pattern, const char *name)
+{
+    const char *star = NULL;
+    const char *resume = NULL;
+    while (*name != '\0')
+    {
+        if (*pattern == '*')
+        {
+            star = pattern++;
+            resume = name;
+        }
+        else if (*pattern == '?' || *pattern == *name)
+        {
+            pattern++;
+            name++;
+        }
+        else if (star != NULL)
+        {
+            pattern = star + 1;
+            name = ++resume;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    while (*pattern == '*')
+    {
+        pattern++;
+    }
+    return *pattern == '\0';
+}
+
+static bool pattern_list_matches(const PatternList *list, const char *name)
+{
+    for (size_t i = 0; i < list->count; i++)
+    {
+        if (glob_match(list->patterns[i], name))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+typedef struct GlobBucket
+{
+    char *segment;
+    PatternList globs;
+} GlobBucket;
+
+// A glob whose text before its first wildcard holds a '.' can only match
+// names with the same first segment, usually the suite, so it is kept in
+// that segment's bucket. Other globs are tried for every name.
+typedef struct GlobIndex
+{
+    NameMap segments;
+    GlobBucket *buckets;
+    size_t bucketCount;
+    size_t bucketCapacity;
+    PatternList general;
+} GlobIndex;
+
+static bool glob_index_empty(const GlobIndex *index)
+{
+    return index->general.count == 0 && index->bucketCount == 0;
+}
+
+static void glob_index_add(GlobIndex *index, const char *pattern)
+{
+    const char *dot = memchr(pattern, '.', strcspn(pattern, "*?"));
+    if (dot == NULL)
+    {
+        pattern_list_add(&index->general, pattern);
+        return;
+    }
+    size_t length = (size_t)(dot - pattern);
+    char *segment = malloc(length + 1);
+    if (segment == NULL)
+    {
+        exit(FATAL);
+    }
+    memcpy(segment, pattern, length);
+    segment[length] = '\0';
+    const NameSlot *slot = name_map_find(&index->segments, segment);
+    if (slot != NULL)
+    {
+        free(segment);
+        pattern_list_add(&index->buckets[slot->value].globs, pattern);
+        return;
+    }
+    if (index->bucketCount == index->bucketCapacity)
+    {
+        index->bucketCapacity = index->bucketCapacity == 0 ? 8 : 2 * index->bucketCapacity;
+        index->buckets = realloc(index->buckets, index->bucketCapacity * sizeof(GlobBucket));
+        if (index->buckets == NULL)
+        {
+            exit(FATAL);
+        }
+    }
+    GlobBucket bucket = {segment, {NULL, 0, 0}};
+    pattern_list_add(&bucket.globs, pattern);
+    name_map_put(&index->segments, segment, index->bucketCount);
+    index->buckets[index->bucketCount++] = bucket;
+}
+
+static bool glob_index_matches(const GlobIndex *index, const char *name, YacuMessageArena *scratch)
+{
+    if (pattern_list_matches(&index->general, name))
+    {
+        return true;
+    }
+    if (index->bucketCount == 0)
+    {
+        return false;
+    }
+    arena_reset(scratch);
+    size_t offset = arena_store(scratch, "%.*s", (int)strcspn(name, "."), name);
+    const NameSlot *slot = name_map_find(&index->segments, scratch->data + offset);
+    return slot != NULL && pattern_list_matches(&index->buckets[slot->value].globs, name);
+}
+
+static void glob_index_free(GlobIndex *index)
+{
+    for (size_t i = 0; i < index->bucketCount; i++)
+    {
+        free(index->buckets[i].segment);
+        free(index->buckets[i].globs.patterns);
+    }
+    free(index->buckets);
+    free(index->segments.slots);
+    free(index->general.patterns);
+}
+
+// Exact names are looked up in hash sets, so long filter files cost one
+// lookup per test. Globs are only tried when their suite matches, see
+// GlobIndex.
+typedef struct TestFilter
+{
+    NameMap includedNames;
+    NameMap excludedNames;
+    GlobIndex includedGlobs;
+    GlobIndex excludedGlobs;
+    char *filterText;
+    char *fileText;
+    YacuMessageArena qualifiedName;
+    YacuMessageArena segment;
+} TestFilter;
+
+static void filter_add_patterns(TestFilter *filter, char *text, const char *separators)
+{
+    for (char *pattern = strtok(text, separators); pattern != NULL; pattern = strtok(NULL, separators))
+    {
+        while (*pattern == ' ' || *pattern == '\t')
+        {
+            pattern++;
+        }
+        size_t length = strlen(pattern);
+        while (length > 0 && strchr(" \t\r", pattern[length - 1]) != NULL)
+        {
+            pattern[--length] = '\0';
+        }
+        if (length == 0 || pattern[0] == '#')
+        {
+            continue;
+        }
+        bool excluded = pattern[0] == '-';
+        pattern += excluded ? 1 : 0;
+        if (strpbrk(pattern, "*?") != NULL)
+        {
+            glob_index_add(excluded ? &filter->excludedGlobs : &filter->includedGlobs, pattern);
+        }
+        else
+        {
+            name_map_put(excluded ? &filter->excludedNames : &filter->includedNames, pattern, 0);
+        }
+    }
+}
+
+static void filter_initialize(TestFilter *filter, const YacuOptions *options)
+{
+    memset(filter, 0, sizeof(TestFilter));
+    if (options->filter != NULL)
+    {
+        filter->filterText = malloc(strlen(options->filter) + 1);
+        if (filter->filterText == NULL)
+        {
+            exit(FATAL);
+        }
+        strcpy(filter->filterText, options->filter);
+        filter_add_patterns(filter, filter->filterText, ",");
+    }
+    if (options->filterFile != NULL)
+    {
+        filter->fileText = read_text_file(options->filterFile, true);
+        filter_add_patterns(filter, filter->fileText, "\n");
+    }
+}
+
+static void filter_free(TestFilter *filter)
+{
+    free(filter->includedNames.slots);
+    free(filter->excludedNames.slots);
+    glob_index_free(&filter->includedGlobs);
+    glob_index_free(&filter->excludedGlobs);
+    free(filter->filterText);
+    free(filter->fileText);
+    arena_free(&filter->qualifiedName);
+    arena_free(&filter->segment);
+}
+
+static bool filter_accepts(TestFilter *filter, const YacuSuite *suite, const YacuTest *test)
+{
+    bool anyIncluded = filter->includedNames.count > 0 || !glob_index_empty(&filter->includedGlobs);
+    bool anyExcluded = filter->excludedNames.count > 0 || !glob_index_empty(&filter->excludedGlobs);
+    if (!anyIncluded && !anyExcluded)
+    {
+        return true;
+    }
+    const char *name = qualified_name(&filter->qualifiedName, suite, test);
+    if (anyIncluded && name_map_find(&filter->includedNames, name) == NULL && !glob_index_matches(&filter->includedGlobs, name, &filter->segment))
+    {
+        return false;
+    }
+    return name_map_find(&filter->excludedNames, name) == NULL && !glob_index_matches(&filter->excludedGlobs, name, &filter->segment);
+}
+
+static bool is_selected(const YacuOptions *options, TestFilter *filter, const YacuSuite *suite, const YacuTest *test)
+{
+    return (options->suiteName == NULL || strcmp(options->suiteName, suite->name) == 0) &&
+           (options->testName == NULL || strcmp(options->testName, test->name) == 0) &&
+           filter_accepts(filter, suite, test);
+}
+
+// Results of earlier runs keyed by "Suite.Test", one "name<TAB>seconds<TAB>
+// status" line per test. Entries of tests that did not run are kept.
+typedef struct CacheEntry
+{
+    char *name;
+    double duration;
+    YacuStatus status;
+} CacheEntry;
+
+typedef struct TestCache
+{
+    const char *path;
+    CacheEntry *entries;
+    size_t count;
+    size_t capacity;
+    NameMap index;
+    double defaultEstimate;
+    YacuMessageArena qualifiedName;
+} TestCache;
+
+static CacheEntry *cache_entry(TestCache *cache, const char *name)
+{
+    const NameSlot *slot = name_map_find(&cache->index, name);
+    if (slot != NULL)
+    {
+        return &cache->entries[slot->value];
+    }
+    if (cache->count == cache->capacity)
+    {
+        cache->capacity = cache->capacity == 0 ? 64 : 2 * cache->capacity;
+        cache->entries = realloc(cache->entries, cache->capacity * sizeof(CacheEntry));
+        if (cache->entries == NULL)
+        {
+            exit(FATAL);
+        }
+    }
+    CacheEntry entry = {malloc(strlen(name) + 1), 0.0, OK};
+    if (entry.name == NULL)
+    {
+        exit(FATAL);
+    }
+    strcpy(entry.name, name);
+    name_map_put(&cache->index, entry.name, cache->count);
+    cache->entries[cache->count] = entry;
+    return &cache->entries[cache->count++];
+}
+
+static void cache_load(TestCache *cache, const char *path)
+{
+    memset(cache, 0, sizeof(TestCache));
+    cache->path = path;
+    cache->defaultEstimate = 1.0;
+    char *text = path != NULL ? read_text_file(path, false) : NULL;
+    if (text == NULL)
+    {
+        return;
+    }
+    for (char *line = strtok(text, "\n"); line != NULL; line = strtok(NULL, "\n"))
+    {
+        char *separator = strchr(line, '\t');
+        char *end = NULL;
+        double duration = separator != NULL ? strtod(separator + 1, &end) : -1.0;
+        if (separator == NULL || end == separator + 1 || !(duration >= 0.0))
+        {
+            continue;
+        }
+        *separator = '\0';
+        CacheEntry *entry = cache_entry(cache, line);
+        entry->duration = duration;
+        entry->status = *end == '\t' ? (YacuStatus)strtol(end + 1, NULL, 10) : OK;
+    }
+    free(text);
+    if (cache->count > 0)
+    {
+        double total = 0.0;
+        for (size_t i = 0; i < cache->count; i++)
+        {
+            total += cache->entries[i].duration;
+        }
+        cache->defaultEstimate = total / (double)cache->count;
+    }
+}
+
+static void cache_save(const TestCache *cache)
+{
+    YacuMessageArena tmpPath = {NULL, 0, 0};
+#ifdef FORK_AVAILABLE
+    arena_store(&tmpPath, "%s.%ld.tmp", cache->path, (long)getpid());
+#else
+    arena_store(&tmpPath, "%s.tmp", cache->path);
+#endif
+    FILE *file = fopen(tmpPath.data, "w");
+    if (file != NULL)
+    {
+        for (size_t i = 0; i < cache->count; i++)
+        {
+            fprintf(file, "%s\t%.6f\t%d\n", cache->entries[i].name, cache->entries[i].duration, cache->entries[i].status);
+        }
+        if (fclose(file) != 0 || rename(tmpPath.data, cache->path) != 0)
+        {
+            remove(tmpPath.data);
+        }
+    }
+    arena_free(&tmpPath);
+}
+
+static void cache_free(TestCache *cache)
+{
+    for (size_t i = 0; i < cache->count; i++)
+    {
+        free(cache->entries[i].name);
+    }
+    free(cache->entries);
+    free(cache->index.slots);
+    arena_free(&cache->qualifiedName);
+}
+
+// Durations are recorded per case, so each case is estimated by its own.
+static double cache_estimate(TestCache *cache, const PlannedTest *planned)
+{
+    const NameSlot *slot = name_map_find(&cache->index, qualified_case_name(&cache->qualifiedName, planned->suite, planned->test, planned->caseIndex, corpus_input_name(planned->test, planned->caseIndex)));
+    return slot != NULL ? cache->entries[slot->value].duration : cache->defaultEstimate;
+}
+
+static bool cache_failed(TestCache *cache, const PlannedTest *planned)
+{
+    const NameSlot *slot = name_map_find(&cache->index, qualified_case_name(&cache->qualifiedName, planned->suite, planned->test, planned->caseIndex, corpus_input_name(planned->test, planned->caseIndex)));
+    return slot != NULL && cache->entries[slot->value].status != OK;
+}
+
+static void cache_report_action(YacuReportState state, YacuReportEvent reportEvent, const YacuSuite *suite, const YacuTestRun *testRun)
+{
+    TestCache *cache = state;
+    if (reportEvent == TEST_RUN_FINISHED && suite != NULL && testRun->test != NULL)
+    {
+        CacheEntry *entry = cache_entry(cache, qualified_case_name(&cache->qualifiedName, suite, testRun->test, testRun->caseIndex, testRun->inputName));
+        entry->duration = testRun->duration;
+        entry->status = testRun->result;
+    }
+    else if (reportEvent == TESTING_FINISHED)
+    {
+        cache_save(cache);
+    }
+}
+
+static TestPlan plan_tests(const YacuOptions *options, const YacuSuite *suites)
+{
+    TestPlan plan = {NULL, 0, 0};
+    size_t capacity = 0;
+    TestFilter filter;
+    filter_initialize(&filter, options);
+    for (const YacuSuite *suiteIt = suites; !end_of_suites(*suiteIt); suiteIt++)
+    {
+        for (const YacuTest *testIt = suiteIt->tests; !end_of_tests(*testIt); testIt++)
+        {
+            if (!is_selected(options, &filter, suiteIt, testIt))
+            {
+                continue;
+            }
+            size_t cases = planned_cases(testIt, options);
+            while (plan.count + cases > capacity)
+            {
+                capacity = capacity == 0 ? 64 : 2 * capacity;
+            }
+            plan.tests = realloc(plan.tests, capacity * sizeof(PlannedTest));
+            if (plan.tests == NULL)
+            {
+                exit(FATAL);
+            }
+            for (size_t caseIndex = 0; caseIndex < cases; caseIndex++)
+            {
+                PlannedTest planned = {suiteIt, testIt, caseIndex};
+                plan.tests[plan.count++] = planned;
+            }
+        }
+    }
+    filter_free(&filter);
+    return plan;
+}
+
+typedef struct ScheduledTest
+{
+    double estimate;
+    size_t index;
+} ScheduledTest;
+
+static int compare_longest_first(const void *left, const void *right)
+{
+    const ScheduledTest *leftTest = left;
+    const ScheduledTest *rightTest = right;
+    if (leftTest->estimate != rightTest->estimate)
+    {
+        return leftTest->estimate > rightTest->estimate ? -1 : 1;
+    }
+    return leftTest->index < rightTest->index ? -1 : (leftTest->index > rightTest->index ? 1 : 0);
+}
+
+static size_t *longest_first(const TestPlan *plan, TestCache *history)
+{
+    ScheduledTest *scheduled = calloc(plan->count + 1, sizeof(ScheduledTest));
+    size_t *order = calloc(plan->count + 1, sizeof(size_t));
+    if (scheduled == NULL || order == NULL)
+    {
+        exit(FATAL);
+    }
+    for (size_t i = 0; i < plan->count; i++)
+    {
+        scheduled[i].estimate = cache_estimate(history, &plan->tests[i]);
+        scheduled[i].index = i;
+    }
+    qsort(scheduled, plan->prioritized, sizeof(ScheduledTest), compare_longest_first);
+    qsort(scheduled + plan->prioritized, plan->count - plan->prioritized, sizeof(ScheduledTest), compare_longest_first);
+    for (size_t i = 0; i < plan->count; i++)
+    {
+        order[i] = scheduled[i].index;
+    }
+    free(scheduled);
+    return order;
+}
+
+static void plan_previous_failures(TestPlan *plan, const YacuOptions *options, TestCache *cache)
+{
+    if ((!options->lastFailed && !options->failedFirst) || plan->count == 0)
+    {
+        return;
+    }
+    PlannedTest *reordered = calloc(plan->count + 1, sizeof(PlannedTest));
+    if (reordered == NULL)
+    {
+        exit(FATAL);
+    }
+    size_t count = 0;
+    for (size_t i = 0; i < plan->count; i++)
+    {
+        if (cache_failed(cache, &plan->tests[i]))
+        {
+            reordered[count++] = plan->tests[i];
+        }
+    }
+    // When no recorded failure is selected, the whole plan runs.
+    if (count == 0)
+    {
+        free(reordered);
+        return;
+    }
+    plan->prioritized = count;
+    for (size_t i = 0; i < plan->count && !options->lastFailed; i++)
+    {
+        if (!cache_failed(cache, &plan->tests[i]))
+        {
+            reordered[count++] = plan->tests[i];
+        }
+    }
+    memcpy(plan->tests, reordered, count * sizeof(PlannedTest));
+    plan->count = count;
+    free(reordered);
+}
+
+// Longest tests first, each with all of its cases to the least loaded
+// shard. Without history every case is estimated the same.
+static void plan_shard(TestPlan *plan, const YacuOptions *options)
+{
+    if (options->shardCount <= 1)
+    {
+        return;
+    }
+    TestCache history;
+    cache_load(&history, options->shardDurations);
+    ScheduledTest *scheduled = calloc(plan->count + 1, sizeof(ScheduledTest));
+    size_t *groups = calloc(plan->count + 1, sizeof(size_t));
+    double *loads = calloc(options->shardCount, sizeof(double));
+    bool *kept = calloc(plan->count + 1, sizeof(bool));
+    if (scheduled == NULL || groups == NULL || loads == NULL || kept == NULL)
+    {
+        exit(FATAL);
+    }
+    // The cases of a test are consecutive in the plan.
+    size_t groupCount = 0;
+    for (size_t i = 0; i < plan->count; i++)
+    {
+        if (i == 0 || plan->tests[i].suite != plan->tests[i - 1].suite || plan->tests[i].test != plan->tests[i - 1].test)
+        {
+            scheduled[groupCount].index = groupCount;
+            groupCount++;
+        }
+        groups[i] = groupCount - 1;
+        scheduled[groupCount - 1].estimate += cache_estimate(&history, &plan->tests[i]);
+    }
+    qsort(scheduled, groupCount, sizeof(ScheduledTest), compare_longest_first);
+    for (size_t i = 0; i < groupCount; i++)
+    {
+        size_t shard = 0;
+        for (size_t candidate = 1; candidate < options->shardCount; candidate++)
+        {
+            if (loads[candidate] < loads[shard])
+            {
+                shard = candidate;
+            }
+        }
+        loads[shard] += scheduled[i].estimate;
+        kept[scheduled[i].index] = shard == options->shardIndex - 1;
+    }
+    size_t count = 0;
+    for (size_t i = 0; i < plan->count; i++)
+    {
+        if (kept[groups[i]])
+        {
+            plan->tests[count++] = plan->tests[i];
+        }
+    }
+    plan->count = count;
+    free(kept);
+    free(loads);
+    free(groups);
+    free(scheduled);
+    cache_free(&history);
+}
+
+static double test_timeout(const YacuTest *test, const YacuOptions *options)
+{
+    return test->timeout > 0.0 ? test->timeout : options->timeout;
+}
+
+static bool plan_has_timeouts(const TestPlan *plan, const YacuOptions *options)
+{
+    for (size_t i = 0; i < plan->count; i++)
+    {
+        if (test_timeout(plan->tests[i].test, options) > 0.0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Corpus inputs always run in workers, which survive inputs that crash.
+static bool plan_has_corpus(const TestPlan *plan)
+{
+    for (size_t i = 0; activeCorpus != NULL && i < plan->count; i++)
+    {
+        if (plan->tests[i].test->fuzz != NULL)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static YacuStatus run_in_process(const TestPlan *plan, YacuReportPtr *reports, const YacuOptions *options)
+{
+    YacuStatus runStatus = OK;
+    RunReporter reporter = {.reports = reports, .suite = NULL};
+    YacuMessageArena arena = {NULL, 0, 0};
+    FixtureCache fixtures = {NULL, 0, 0, false};
+    for (size_t i = 0; i < plan->count; i++)
+    {
+        reporter_enter_suite(&reporter, plan->tests[i].suite);
+        runStatus = merge_status(runStatus, yacu_run_test(&plan->tests[i], reports, options, &reporter, &arena, &fixtures));
+    }
+    fixtures_free(&fixtures, options->runData);
+    reporter_leave_suite(&reporter);
+    arena_free(&arena);
+    return runStatus;
+}
+
+#ifdef FORK_AVAILABLE
+
+static bool write_all(int fd, const void *data, size_t size)
+{
+    const char *bytes = data;
+    while (size > 0)
+    {
+        ssize_t written = write(fd, bytes, size);
+        if (written < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (written <= 0)
+        {
+            return false;
+        }
+        bytes += written;
+        size -= (size_t)written;
+    }
+    return true;
+}
+
+static bool read_all(int fd, void *data, size_t size)
+{
+    char *bytes = data;
+    while (size > 0)
+    {
+        ssize_t readCount = read(fd, bytes, size);
+        if (readCount < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (readCount <= 0)
+        {
+            return false;
+        }
+        bytes += readCount;
+        size -= (size_t)readCount;
+    }
+    return true;
+}
+
+// Forked tests write their run into a slot of a MAP_SHARED region that is
+// mapped before fork, one slot per worker. The pipe only carries a wakeup
+// with the length of the message tail that did not fit into the slot.
+typedef struct ResultSlot
+{
+    YacuTestRun run;
+    bool written;
+    uint64_t messageLength;
+    size_t capacity;
+    char message[];
+} ResultSlot;
+
+typedef struct ResultSlots
+{
+    char *region;
+    size_t stride;
+    size_t count;
+} ResultSlots;
+
+static void result_slots_map(ResultSlots *slots, size_t count, size_t capacity)
+{
+    // Slots are cache line aligned so that workers do not share lines.
+    slots->stride = (sizeof(ResultSlot) + capacity + 63) & ~(size_t)63;
+    slots->count = count;
+    void *region = mmap(NULL, slots->stride * count, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (region == MAP_FAILED)
+    {
+        exit(FATAL);
+    }
+    slots->region = region;
+    for (size_t i = 0; i < count; i++)
+    {
+        ((ResultSlot *)(slots->region + i * slots->stride))->capacity = capacity;
+    }
+}
+
+static ResultSlot *result_slot(const ResultSlots *slots, size_t index)
+{
+    return (ResultSlot *)(slots->region + index * slots->stride);
+}
+
+static void result_slots_unmap(ResultSlots *slots)
+{
+    munmap(slots->region, slots->stride * slots->count);
+}
+
+// Each result of a chunk of cases goes to the next slot of the worker.
+typedef struct ChannelReport
+{
+    int fd;
+    const ResultSlots *slots;
+    size_t firstSlot;
+    size_t next;
+} ChannelReport;
+
+static void channel_report_action(YacuReportState state, YacuReportEvent reportEvent, const YacuSuite *suite, const YacuTestRun *testRun)
+{
+    UNUSED(suite);
+    if (reportEvent != TEST_RUN_FINISHED)
+    {
+        return;
+    }
+    // The run is shipped verbatim; the receiver rebinds its pointer fields.
+    ChannelReport *channel = (ChannelReport *)state;
+    ResultSlot *slot = result_slot(channel->slots, channel->firstSlot + channel->next++);
+    size_t inSlot = testRun->messageLength < slot->capacity ? testRun->messageLength : slot->capacity;
+    slot->run = *testRun;
+    slot->messageLength = testRun->messageLength;
+    memcpy(slot->message, testRun->message, inSlot);
+    slot->written = true;
+    uint64_t overflow = testRun->messageLength - inSlot;
+    if (channel->fd >= 0 && write_all(channel->fd, &overflow, sizeof(overflow)))
+    {
+        write_all(channel->fd, testRun->message + inSlot, (size_t)overflow);
+    }
+}
+
+// A worker runs the plan range [test, test + chunk), which is longer than
+// one test only for consecutive cases of a parameterized test.
+typedef struct Worker
+{
+    YacuProcessHandle pid;
+    size_t firstSlot;
+    int taskFd;
+    int resultFd;
+    size_t test;
+    size_t chunk;
+    size_t received;
+    bool busy;
+    double dispatchTime;
+} Worker;
+
+typedef struct PlanRange
+{
+    size_t first;
+    size_t count;
+} PlanRange;
+
+typedef struct TestOutcome
+{
+    bool finished;
+    YacuTestRun run;
+    size_t messageOffset;
+} TestOutcome;
+
+typedef struct WorkerPool
+{
+    const TestPlan *plan;
+    const YacuOptions *options;
+    Worker *workers;
+    size_t workerCount;
+    ResultSlots slots;
+    TestOutcome *outcomes;
+    YacuMessageArena messages;
+    const size_t *order;
+    size_t dispatched;
+    // Unfinished rests of chunks whose worker died; dispatched first.
+    PlanRange *retries;
+    size_t retryCount;
+    size_t finished;
+    size_t reported;
+    RunReporter reporter;
+    YacuStatus runStatus;
+    bool isolated;
+    FixtureCache fixtures;
+    struct sigaction sigpipeAction;
+} WorkerPool;
+
+static void worker_loop(const TestPlan *plan, const YacuOptions *options, int taskFd, int resultFd, const ResultSlots *slots, size_t firstSlot)
+{
+    ChannelReport channelState = {resultFd, slots, firstSlot, 0};
+    YacuReport channelReport = {&channelState, channel_report_action};
+    YacuReportPtr reports[] = {&channelReport, &END_OF_REPORTS};
+    YacuMessageArena arena = {NULL, 0, 0};
+    FixtureCache fixtures = {NULL, 0, 0, true};
+    uint64_t task[2];
+    while (read_all(taskFd, task, sizeof(task)) && task[0] < plan->count && task[1] <= plan->count - task[0])
+    {
+        channelState.next = 0;
+        for (uint64_t index = task[0]; index < task[0] + task[1]; index++)
+        {
+            yacu_run_test(&plan->tests[index], reports, options, NULL, &arena, &fixtures);
+        }
+    }
+    fixtures_free(&fixtures, options->runData);
+    fflush(stdout);
+    fflush(stderr);
+    _exit(OK);
+}
+
+static void isolated_run(const PlannedTest *planned, const YacuOptions *options, const FixtureCache *inherited, int resultFd, const ResultSlots *slots, size_t firstSlot)
+{
+    ChannelReport channelState = {resultFd, slots, firstSlot, 0};
+    YacuReport channelReport = {&channelState, channel_report_action};
+    YacuReportPtr reports[] = {&channelReport, &END_OF_REPORTS};
+    YacuMessageArena arena = {NULL, 0, 0};
+    FixtureCache fixtures = *inherited;
+    YacuStatus status = yacu_run_test(planned, reports, options, NULL, &arena, &fixtures);
+    // Only a fixture whose setup failed in the pool is retried here.
+    FixtureCache own = {fixtures.entries + inherited->count, fixtures.count - inherited->count, 0, true};
+    fixtures_release(&own, options->runData);
+    fflush(stdout);
+    fflush(stderr);
+    _exit(status);
+}
+
+static void pool_close_inherited(WorkerPool *pool)
+{
+    sigaction(SIGPIPE, &pool->sigpipeAction, NULL);
+    for (size_t i = 0; i < pool->workerCount; i++)
+    {
+        if (pool->workers[i].pid > 0)
+        {
+            if (pool->workers[i].taskFd >= 0)
+            {
+                close(pool->workers[i].taskFd);
+            }
+            close(pool->workers[i].resultFd);
+        }
+    }
+}
+
+// A failed setup is not kept, so the test process runs it again and
+// reports the failure with its test.
+static void pool_prepare_fixture(WorkerPool *pool, const PlannedTest *planned)
+{
+    YacuMessageArena arena = {NULL, 0, 0};
+    YacuTestRun setupRun = {.result = OK, .message = "", .arena = &arena, .runData = pool->options->runData, .globalState = activeGlobalState, .test = planned->test, .suite = planned->suite};
+    fixture_acquire(&pool->fixtures, &setupRun);
+    arena_free(&arena);
+}
+
+static void pool_spawn_isolated(WorkerPool *pool, Worker *worker, size_t test)
+{
+    pool_prepare_fixture(pool, &pool->plan->tests[test]);
+    int resultPipe[2];
+    if (pipe(resultPipe) != 0)
+    {
+        exit(FORK_FAIL);
+    }
+    YacuProcessHandle pid = yacu_fork();
+    if (yacu_is_forked(pid))
+    {
+        pool_close_inherited(pool);
+        close(resultPipe[0]);
+        isolated_run(&pool->plan->tests[test], pool->options, &pool->fixtures, resultPipe[1], &pool->slots, worker->firstSlot);
+    }
+    close(resultPipe[1]);
+    worker->pid = pid;
+    worker->taskFd = -1;
+    worker->resultFd = resultPipe[0];
+    worker->test = test;
+    worker->chunk = 1;
+    worker->received = 0;
+    worker->busy = true;
+}
+
+static void pool_spawn_worker(WorkerPool *pool, Worker *worker)
+{
+    int taskPipe[2];
+    int resultPipe[2];
+    if (pipe(taskPipe) != 0)
+    {
+        exit(FORK_FAIL);
+    }
+    if (pipe(resultPipe) != 0)
+    {
+        exit(FORK_FAIL);
+    }
+    YacuProcessHandle pid = yacu_fork();
+    if (yacu_is_forked(pid))
+    {
+        pool_close_inherited(pool);
+        close(taskPipe[1]);
+        close(resultPipe[0]);
+        worker_loop(pool->plan, pool->options, taskPipe[0], resultPipe[1], &pool->slots, worker->firstSlot);
+    }
+    close(taskPipe[0]);
+    close(resultPipe[1]);
+    worker->pid = pid;
+    worker->taskFd = taskPipe[1];
+    worker->resultFd = resultPipe[0];
+    worker->busy = false;
+}
+
+static int pool_reap_worker(Worker *worker, YacuResourceUsage *usage)
+{
+    int status = 0;
+    struct rusage rusage;
+    if (worker->taskFd >= 0)
+    {
+        close(worker->taskFd);
+    }
+    close(worker->resultFd);
+    while (wait4(worker->pid, &status, 0, &rusage) < 0 && errno == EINTR)
+    {
+    }
+    if (usage != NULL)
+    {
+        usage_from_rusage(&rusage, usage);
+    }
+    worker->pid = 0;
+    worker->busy = false;
+    return status;
+}
+
+static bool pool_next_range(const WorkerPool *pool, PlanRange *range)
+{
+    if (pool->retryCount > 0)
+    {
+        *range = pool->retries[pool->retryCount - 1];
+        return true;
+    }
+    const TestPlan *plan = pool->plan;
+    if (pool->dispatched >= plan->count)
+    {
+        return false;
+    }
+    range->first = pool->order[pool->dispatched];
+    range->count = 1;
+    const YacuTest *test = plan->tests[range->first].test;
+    while (!pool->isolated && (test->caseCount > 0 || test->fuzz != NULL) && range->count < YACU_CASE_CHUNK_SIZE &&
+           pool->dispatched + range->count < plan->count &&
+           pool->order[pool->dispatched + range->count] == range->first + range->count &&
+           plan->tests[range->first + range->count].test == test)
+    {
+        range->count++;
+    }
+    return true;
+}
+
+static void pool_take_range(WorkerPool *pool, const PlanRange *range)
+{
+    if (pool->retryCount > 0)
+    {
+        pool->retryCount--;
+    }
+    else
+    {
+        pool->dispatched += range->count;
+    }
+}
+
+static void pool_requeue_rest(WorkerPool *pool, const Worker *worker)
+{
+    size_t done = worker->received + 1;
+    if (done >= worker->chunk)
+    {
+        return;
+    }
+    PlanRange *retries = realloc(pool->retries, (pool->retryCount + 1) * sizeof(PlanRange));
+    if (retries == NULL)
+    {
+        exit(FATAL);
+    }
+    pool->retries = retries;
+    PlanRange rest = {worker->test + done, worker->chunk - done};
+    pool->retries[pool->retryCount++] = rest;
+}
+
+static void pool_dispatch(WorkerPool *pool, Worker *worker)
+{
+    PlanRange range;
+    while (pool_next_range(pool, &range))
+    {
+        worker->dispatchTime = yacu_now();
+        if (pool->isolated)
+        {
+            pool_take_range(pool, &range);
+            pool_spawn_isolated(pool, worker, range.first);
+            return;
+        }
+        if (worker->pid == 0)
+        {
+            pool_spawn_worker(pool, worker);
+        }
+        uint64_t task[2] = {range.first, range.count};
+        if (write_all(worker->taskFd, task, sizeof(task)))
+        {
+            pool_take_range(pool, &range);
+            worker->test = range.first;
+            worker->chunk = range.count;
+            worker->received = 0;
+            worker->busy = true;
+            return;
+        }
+        // The worker has exited during its previous test.
+        pool_reap_worker(worker, NULL);
+    }
+}
+
+static bool receive_outcome(int fd, const ResultSlot *slot, TestOutcome *outcome, YacuMessageArena *messages)
+{
+    uint64_t overflow;
+    if (!read_all(fd, &overflow, sizeof(overflow)) || !slot->written || overflow > slot->messageLength)
+    {
+        return false;
+    }
+    uint64_t messageLength = slot->messageLength;
+    size_t inSlot = (size_t)(messageLength - overflow);
+    outcome->run = slot->run;
+    arena_reserve(messages, (size_t)messageLength + 1);
+    memcpy(messages->data + messages->length, slot->message, inSlot);
+    if (!read_all(fd, messages->data + messages->length + inSlot, (size_t)overflow))
+    {
+        return false;
+    }
+    outcome->messageOffset = messages->length;
+    outcome->run.messageLength = (size_t)messageLength;
+    messages->length += (size_t)messageLength;
+    messages->data[messages->length++] = '\0';
+    return true;
+}
+
+static void pool_collect(WorkerPool *pool, Worker *worker)
+{
+    TestOutcome *outcome = &pool->outcomes[worker->test + worker->received];
+    const ResultSlot *slot = result_slot(&pool->slots, worker->firstSlot + worker->received);
+    if (receive_outcome(worker->resultFd, slot, outcome, &pool->messages))
+    {
+        worker->received++;
+        worker->busy = worker->received < worker->chunk;
+        if (pool->isolated)
+        {
+            pool_reap_worker(worker, &outcome->run.usage);
+        }
+    }
+    else
+    {
+        pool_requeue_rest(pool, worker);
+        YacuResourceUsage usage;
+        int status = pool_reap_worker(worker, &usage);
+        YacuTestRun errorRun = {.result = TEST_ERROR, .startTime = worker->dispatchTime, .duration = yacu_now() - worker->dispatchTime};
+        outcome->run = errorRun;
+        if (pool->isolated)
+        {
+            outcome->run.usage = usage;
+        }
+        if (WIFSIGNALED(status))
+        {
+            outcome->messageOffset = arena_store(&pool->messages, "Test process killed by signal %d", WTERMSIG(status));
+        }
+        else
+        {
+            outcome->messageOffset = arena_store(&pool->messages, "Test process exited with status %d", WEXITSTATUS(status));
+        }
+        outcome->run.messageLength = pool->messages.length - outcome->messageOffset - 1;
+    }
+    double now = yacu_now();
+    double elapsed = now - worker->dispatchTime;
+    outcome->run.overhead = elapsed > outcome->run.duration ? elapsed - outcome->run.duration : 0.0;
+    outcome->finished = true;
+    pool->finished++;
+    worker->dispatchTime = now;
+}
+
+static double pool_deadline(const WorkerPool *pool, const Worker *worker)
+{
+    double timeout = test_timeout(pool->plan->tests[worker->test].test, pool->options);
+    return timeout > 0.0 ? worker->dispatchTime + timeout : -1.0;
+}
+
+static int pool_poll_timeout(const WorkerPool *pool)
+{
+    double nearest = -1.0;
+    for (size_t i = 0; i < pool->workerCount; i++)
+    {
+        double deadline = pool->workers[i].busy ? pool_deadline(pool, &pool->workers[i]) : -1.0;
+        if (deadline >= 0.0 && (nearest < 0.0 || deadline < nearest))
+        {
+            nearest = deadline;
+        }
+    }
+    if (nearest < 0.0)
+    {
+        return -1;
+    }
+    double remaining = ceil((nearest - yacu_now()) * 1e3);
+    return remaining > 0.0 ? (remaining < INT_MAX ? (int)remaining : INT_MAX) : 0;
+}
+
+static void pool_expire(WorkerPool *pool, Worker *worker)
+{
+    double deadline = pool_deadline(pool, worker);
+    if (deadline < 0.0 || yacu_now() < deadline)
+    {
+        return;
+    }
+    TestOutcome *outcome = &pool->outcomes[worker->test + worker->received];
+    double timeout = test_timeout(pool->plan->tests[worker->test].test, pool->options);
+    pool_requeue_rest(pool, worker);
+    kill(worker->pid, SIGKILL);
+    YacuResourceUsage usage;
+    pool_reap_worker(worker, &usage);
+    YacuTestRun timeoutRun = {.result = TEST_TIMEOUT, .startTime = worker->dispatchTime, .duration = yacu_now() - worker->dispatchTime};
+    outcome->run = timeoutRun;
+    if (pool->isolated)
+    {
+        outcome->run.usage = usage;
+    }
+    outcome->messageOffset = arena_store(&pool->messages, "Test timed out after %.3f s", timeout);
+    outcome->run.messageLength = pool->messages.length - outcome->messageOffset - 1;
+    outcome->finished = true;
+    pool->finished++;
+}
+
+static void pool_report_finished(WorkerPool *pool)
+{
+    while (pool->reported < pool->plan->count && pool->outcomes[pool->reported].finished)
+    {
+        const PlannedTest *planned = &pool->plan->tests[pool->reported];
+        TestOutcome *outcome = &pool->outcomes[pool->reported];
+        reporter_enter_suite(&pool->reporter, planned->suite);
+        YacuTestRun startedRun = {.result = OK, .message = "", .reports = pool->reporter.reports, .runData = pool->options->runData,
+                                  .testCase = case_data(planned->test, planned->caseIndex), .caseIndex = planned->caseIndex,
+                                  .inputName = corpus_input_name(planned->test, planned->caseIndex), .test = planned->test, .suite = planned->suite};
+        on_test_started(startedRun.reports, planned->suite, &startedRun);
+        YacuTestRun testRun = outcome->run;
+        testRun.message = pool->messages.data + outcome->messageOffset;
+        testRun.arena = NULL;
+        testRun.abortJump = NULL;
+        testRun.reports = startedRun.reports;
+        testRun.runData = startedRun.runData;
+        testRun.globalState = activeGlobalState;
+        testRun.fixture = NULL;
+        testRun.testFixture = NULL;
+        testRun.testCase = startedRun.testCase;
+        testRun.caseIndex = startedRun.caseIndex;
+        testRun.inputName = startedRun.inputName;
+        testRun.test = planned->test;
+        testRun.suite = planned->suite;
+        reporter_record(&pool->reporter, &testRun);
+        on_test_finished(testRun.reports, planned->suite, &testRun);
+        pool->runStatus = merge_status(pool->runStatus, testRun.result);
+        pool->reported++;
+    }
+    if (pool->reported == pool->finished)
+    {
+        arena_reset(&pool->messages);
+    }
+}
+
+static YacuStatus run_in_workers(const TestPlan *plan, const size_t *order, YacuReportPtr *reports, const YacuOptions *options, size_t jobs)
+{
+    WorkerPool pool = {.plan = plan, .order = order, .options = options, .reporter = {.reports = reports, .suite = NULL}, .runStatus = OK, .isolated = options->isolated, .fixtures = {.keep = true}};
+    pool.workerCount = jobs < plan->count ? jobs : plan->count;
+    pool.workers = calloc(pool.workerCount, sizeof(Worker));
+    pool.outcomes = calloc(plan->count, sizeof(TestOutcome));
+    struct pollfd *pollFds = calloc(pool.workerCount, sizeof(struct pollfd));
+    Worker **polledWorkers = calloc(pool.workerCount, sizeof(Worker *));
+    if (pool.workers == NULL || pool.outcomes == NULL || pollFds == NULL || polledWorkers == NULL)
+    {
+        exit(FATAL);
+    }
+    result_slots_map(&pool.slots, pool.workerCount * YACU_CASE_CHUNK_SIZE, YACU_RESULT_SLOT_MESSAGE_SIZE);
+    for (size_t i = 0; i < pool.workerCount; i++)
+    {
+        pool.workers[i].firstSlot = i * YACU_CASE_CHUNK_SIZE;
+    }
+    struct sigaction ignoreSigpipe;
+    memset(&ignoreSigpipe, 0, sizeof(ignoreSigpipe));
+    ignoreSigpipe.sa_handler = SIG_IGN;
+    sigaction(SIGPIPE, &ignoreSigpipe, &pool.sigpipeAction);
+
+    while (pool.finished < plan->count)
+    {
+        nfds_t polled = 0;
+        for (size_t i = 0; i < pool.workerCount; i++)
+        {
+            Worker *worker = &pool.workers[i];
+            if (!worker->busy)
+            {
+                pool_dispatch(&pool, worker);
+            }
+            if (worker->busy)
+            {
+                pollFds[polled].fd = worker->resultFd;
+                pollFds[polled].events = POLLIN;
+                pollFds[polled].revents = 0;
+                polledWorkers[polled++] = worker;
+            }
+        }
+        if (poll(pollFds, polled, pool_poll_timeout(&pool)) < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            exit(FATAL);
+        }
+        for (nfds_t i = 0; i < polled; i++)
+        {
+            if (pollFds[i].revents != 0)
+            {
+                pool_collect(&pool, polledWorkers[i]);
+            }
+            else
+            {
+                pool_expire(&pool, polledWorkers[i]);
+            }
+        }
+        pool_report_finished(&pool);
+    }
+    reporter_leave_suite(&pool.reporter);
+
+    for (size_t i = 0; i < pool.workerCount; i++)
+    {
+        if (pool.workers[i].pid > 0)
+        {
+            pool_reap_worker(&pool.workers[i], NULL);
+        }
+    }
+    sigaction(SIGPIPE, &pool.sigpipeAction, NULL);
+    fixtures_free(&pool.fixtures, options->runData);
+    result_slots_unmap(&pool.slots);
+    free(pool.retries);
+    free(polledWorkers);
+    free(pollFds);
+    arena_free(&pool.messages);
+    free(pool.outcomes);
+    free(pool.workers);
+    return pool.runStatus;
+}
+
+#endif
+
+YacuProcessHandle yacu_fork()
+{
+    fflush(stdout);
+    fflush(stderr);
+#ifdef FORK_AVAILABLE
+    // A reporter thread may be printing; the child must not inherit its
+    // stdio locks.
+    flockfile(stdout);
+    flockfile(stderr);
+    pid_t pid = fork();
+    funlockfile(stderr);
+    funlockfile(stdout);
+    if (pid < 0)
+    {
+        exit(FORK_FAIL);
+    }
+    return pid;
+#else
+    return -1;
+#endif
+}
+
+bool yacu_is_forked(YacuProcessHandle pid)
+{
+#ifdef FORK_AVAILABLE
+    return pid == 0;
+#else
+    UNUSED(pid);
+    return false;
+#endif
+}
+
+YacuStatus yacu_wait_for_forked(YacuProcessHandle forkedId)
+{
+#ifdef FORK_AVAILABLE
+    int status = 0;
+    while (waitpid(forkedId, &status, 0) < 0)
+    {
+        if (errno != EINTR)
+        {
+            return FORK_FAIL;
+        }
+    }
+    if (WIFEXITED(status))
+    {
+        return (YacuStatus)WEXITSTATUS(status);
+    }
+    return TEST_ERROR;
+#else
+    UNUSED(forkedId);
+    return OK;
+#endif
+}
+
+YacuStatus yacu_forked_test(YacuTestFcn forkedFcn, const void *runData, char *message, size_t messageSize)
+{
+#ifdef FORK_AVAILABLE
+    // The child exits right after reporting, so waiting for it is the only
+    // synchronization the slot needs.
+    ResultSlots slots;
+    result_slots_map(&slots, 1, messageSize > 0 ? messageSize - 1 : 0);
+    ResultSlot *slot = result_slot(&slots, 0);
+    YacuProcessHandle pid = yacu_fork();
+    if (yacu_is_forked(pid))
+    {
+        ChannelReport channelState = {-1, &slots, 0, 0};
+        YacuReport channelReport = {&channelState, channel_report_action};
+        YacuReportPtr reports[] = {&channelReport, &END_OF_REPORTS};
+        YacuMessageArena arena = {NULL, 0, 0};
+        YacuTestRun forkedTestRun = {.result = OK, .message = "", .arena = &arena, .reports = reports, .runData = runData};
+        start_timing(&forkedTestRun);
+        forkedFcn(&forkedTestRun);
+        stop_timing(&forkedTestRun);
+        on_test_finished(reports, NULL, &forkedTestRun);
+        fflush(stdout);
+        fflush(stderr);
+        _exit(forkedTestRun.result);
+    }
+    YacuStatus status = yacu_wait_for_forked(pid);
+    size_t messageLength = slot->written && slot->messageLength < slot->capacity ? (size_t)slot->messageLength : slot->capacity;
+    snprintf(message, messageSize, "%.*s", slot->written ? (int)messageLength : 0, slot->message);
+    status = slot->written ? slot->run.result : status;
+    result_slots_unmap(&slots);
+    return status;
+#else
+    UNUSED(forkedFcn);
+    UNUSED(runData);
+    snprintf(message, messageSize, "Forking is not available on this platform");
+    return FORK_FAIL;
+#endif
+}
+
+static size_t resolve_jobs(int jobs)
+{
+#ifdef FORK_AVAILABLE
+    if (jobs == 0)
+    {
+        long processors = sysconf(_SC_NPROCESSORS_ONLN);
+        return processors > 0 ? (size_t)processors : 1;
+    }
+#endif
+    return jobs > 0 ? (size_t)jobs : 1;
+}
+
+YacuStatus yacu_execute(YacuOptions options, const YacuSuite *suites)
+{
+    YacuStatus runStatus = OK;
+    double startTime = yacu_now();
+    JUnitReport jUnitState;
+    junit_initialize(&jUnitState, options.jUnitPath);
+    YacuReport jUnitReport = {&jUnitState, junit_report_action};
+    StdoutReport stdoutState = {.slowestTests = NULL, .slowestCapacity = options.slowest, .slowestCount = 0};
+    if (options.slowest > 0)
+    {
+        stdoutState.slowestTests = calloc(options.slowest, sizeof(SlowTest));
+        if (stdoutState.slowestTests == NULL)
+        {
+            exit(FATAL);
+        }
+    }
+    YacuReport stdoutReport = {&stdoutState, stdout_report_action};
+    TestCache cache;
+    cache_load(&cache, options.cachePath);
+    YacuReport cacheReport = {&cache, cache_report_action};
+    BinaryLogReport binaryLogState;
+    binary_log_initialize(&binaryLogState, options.binaryLogPath);
+    YacuReport binaryLogReport = {&binaryLogState, binary_log_report_action};
+    BenchmarkBaseline baseline;
+    baseline_load(&baseline, options.benchmarkBaseline);
+    BenchmarkBaseline *outerBaseline = activeBaseline;
+    activeBaseline = options.benchmarkBaseline != NULL ? &baseline : NULL;
+    BenchmarkBaseline savedBaseline;
+    baseline_load(&savedBaseline, options.saveBenchmarkBaseline);
+    YacuReport baselineReport = {&savedBaseline, baseline_report_action};
+    Corpus corpus;
+    corpus_load(&corpus, options.corpusPath);
+    Corpus *outerCorpus = activeCorpus;
+    // An empty corpus would plan no fuzz cases, so it runs as no corpus.
+    activeCorpus = options.corpusPath != NULL && corpus.count > 0 ? &corpus : NULL;
+    if (options.corpusPath != NULL && corpus.count == 0)
+    {
+        fprintf(stderr, "Corpus %s has no inputs, fuzz targets run once on an empty input\n", options.corpusPath);
+    }
+
+    YacuReportPtr reports[] = {&jUnitReport, options.stdoutReport ? &stdoutReport : NULL, options.customReport,
+                               options.cachePath != NULL ? &cacheReport : NULL,
+                               options.saveBenchmarkBaseline != NULL ? &baselineReport : NULL,
+                               options.binaryLogPath != NULL ? &binaryLogReport : NULL, &END_OF_REPORTS};
+
+    YacuReportPtr *dispatched = reports;
+#ifdef FORK_AVAILABLE
+    AsyncReport *asyncState = options.asyncReports ? async_start(reports) : NULL;
+    YacuReport asyncReport = {asyncState, async_report_action};
+    YacuReportPtr asyncReports[] = {&asyncReport, &END_OF_REPORTS};
+    if (asyncState != NULL)
+    {
+        dispatched = asyncReports;
+    }
+#endif
+
+    TestPlan plan = plan_tests(&options, suites);
+    plan_shard(&plan, &options);
+    plan_previous_failures(&plan, &options, &cache);
+    size_t jobs = resolve_jobs(options.jobs);
+    void *outerGlobalState = activeGlobalState;
+    activeGlobalState = options.globalSetup != NULL ? options.globalSetup(options.runData) : NULL;
+#ifdef FORK_AVAILABLE
+    if (plan.count > 0 && (options.isolated || (jobs > 1 && plan.count > 1) || plan_has_timeouts(&plan, &options) || plan_has_corpus(&plan)))
+    {
+        size_t *order = longest_first(&plan, &cache);
+        runStatus = run_in_workers(&plan, order, dispatched, &options, jobs);
+        free(order);
+    }
+    else
+#endif
+    {
+        runStatus = run_in_process(&plan, dispatched, &options);
+    }
+    if (options.globalTeardown != NULL)
+    {
+        options.globalTeardown(options.runData, activeGlobalState);
     }
-    on_testing_finished(reports);
+    activeGlobalState = outerGlobalState;
+    free(plan.tests);
+    YacuTestRun summaryRun = {.result = runStatus, .message = "", .reports = dispatched, .startTime = startTime, .duration = yacu_now() - startTime};
+    on_testing_finished(dispatched, &summaryRun);
+#ifdef FORK_AVAILABLE
+    free(asyncState);
+#endif
+    activeBaseline = outerBaseline;
+    activeCorpus = outerCorpus;
+    corpus_free(&corpus);
+    baseline_free(&savedBaseline);
+    baseline_free(&baseline);
+    cache_free(&cache);
+    free(stdoutState.slowestTests);
     return runStatus;
 }
@@ -28,10 +28,23 @@ SOFTWARE.
 #define YACU_H
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdarg.h>
 #include <string.h>
+#include <setjmp.h>
+
+#if defined(__unix__) || defined(UNIX) || defined(__linux__) || defined(LINUX)
+#define FORK_AVAILABLE
+#include <unistd.h>
+#include <sys/wait.h>
+typedef pid_t YacuProcessHandle;
+typedef sigjmp_buf YacuJumpBuffer;
+#else
+typedef int YacuProcessHandle;
+typedef jmp_buf YacuJumpBuffer;
+#endif
 
 typedef enum YacuStatus
 {
@@ -41,6 +54,7 @@ typedef enum YacuStatus
     FORK_FAIL = 3,
     FILE_FAIL = 4,
     TEST_ERROR = 5,
+    TEST_TIMEOUT = 6,
     FATAL = 99,
 } YacuStatus;
 
@@ -70,6 +84,11 @@ typedef YacuReport *YacuReportPtr;
 
 extern YacuReport END_OF_REPORTS;
 
+// The global setup runs once before any test is forked and its result is
+// every test's testRun->globalState; the teardown gets it back to free it.
+typedef void *(*YacuGlobalSetupFcn)(const void *runData);
+typedef void (*YacuGlobalTeardownFcn)(const void *runData, void *globalState);
+
 typedef struct YacuOptions
 {
     const char *suiteName;
@@ -78,6 +97,55 @@ typedef struct YacuOptions
     bool stdoutReport;
     YacuReport *customReport;
     const void *runData;
+    int jobs;
+    bool isolated;
+    YacuGlobalSetupFcn globalSetup;
+    YacuGlobalTeardownFcn globalTeardown;
+    size_t slowest;
+    double benchmarkTime;
+    size_t benchmarkWarmups;
+    size_t benchmarkRepetitions;
+    double timeout;
+    // Benchmarks slower than the saved baseline by more than the relative
+    // threshold, with Mann-Whitney p < YACU_BENCHMARK_ALPHA, fail.
+    const char *benchmarkBaseline;
+    const char *saveBenchmarkBaseline;
+    double regressionThreshold;
+    // Runs only the tests of shard shardIndex (1-based) out of shardCount.
+    // A shardCount of 0 or 1 disables sharding.
+    size_t shardIndex;
+    size_t shardCount;
+    // Comma separated "Suite.Test" names or globs with * and ?. A leading
+    // '-' excludes. The file holds one such pattern per line. Globs that
+    // spell out their suite are only tried on that suite's tests; globs
+    // with a wildcard in the suite are tried on every test.
+    const char *filter;
+    const char *filterFile;
+    // Test durations and results are kept in cachePath (--cache, off by
+    // default; --no-cache drops an earlier --cache, e.g. one baked into a
+    // wrapper script) and parallel runs start the longest tests first.
+    // Shards get whole tests, balanced by the durations in shardDurations,
+    // which all shards must share.
+    const char *cachePath;
+    const char *shardDurations;
+    bool perfCounters;
+    // Select or front-load the tests that did not pass in the cached run.
+    // lastFailed needs a cachePath and runs every test when none failed.
+    bool lastFailed;
+    bool failedFirst;
+    // Reports run on a reporter thread fed through a bounded event ring of
+    // YACU_REPORT_QUEUE_SIZE events. Ignored where threads are unavailable.
+    bool asyncReports;
+    // Results are appended to this file as fixed-layout YacuLog records.
+    const char *binaryLogPath;
+    // Property tests run propertyCases cases each when it is positive.
+    // Case n draws its inputs from a generator seeded by propertySeed and
+    // n alone, so a reported case is reproduced on any number of jobs.
+    size_t propertyCases;
+    uint64_t propertySeed;
+    // Fuzz targets replay every file of this directory; without one, or
+    // when it has no inputs, they run once on an empty input.
+    const char *corpusPath;
 } YacuOptions;
 
 YacuOptions yacu_default_options();
@@ -86,68 +154,402 @@ struct YacuTestRun;
 
 typedef void (*YacuTestFcn)(struct YacuTestRun *testRun);
 
+typedef void (*YacuBenchmarkFcn)(struct YacuTestRun *testRun, size_t iterations);
+
+// Setup hooks store what they build in testRun->fixture (suite) or
+// testRun->testFixture (test) and may fail with YACU_ASSERT.
+typedef void (*YacuFixtureFcn)(struct YacuTestRun *testRun);
+
+// Same as LLVMFuzzerTestOneInput, so existing fuzz targets plug in as is.
+typedef int (*YacuFuzzFcn)(const uint8_t *data, size_t size);
+
+// Fills the caseSize bytes of testCase with case number index.
+typedef void (*YacuCaseGenerator)(size_t index, void *testCase, const void *runData);
+
 typedef struct YacuTest
 {
     const char *name;
     YacuTestFcn fcn;
+    YacuBenchmarkFcn benchmark;
+    // Seconds; overrides YacuOptions.timeout when positive. Timeouts are
+    // enforced by running tests in forked workers.
+    double timeout;
+    // Run around every test, with the suite fixture already in place.
+    YacuFixtureFcn setup;
+    YacuFixtureFcn teardown;
+    // A parameterized test runs once per case, each reported as its own
+    // "Test/index", with testRun->testCase pointing at the case. Cases come
+    // from the contiguous table cases, or from generate when it is set.
+    const void *cases;
+    size_t caseSize;
+    size_t caseCount;
+    YacuCaseGenerator generate;
+    // A property test runs propertyCases random cases whose inputs come
+    // from the yacu_draw_* functions, in batches of YACU_PROPERTY_BATCH_SIZE
+    // cases reported as "Test/batch". The first failing case of a batch is
+    // shrunk and its minimal inputs are added to the message.
+    size_t propertyCases;
+    // A fuzz target replays each corpus file as a case reported as
+    // "Test/file", in forked workers so that an input that crashes or
+    // times out fails alone. Returns other than 0 and -1 fail the input.
+    YacuFuzzFcn fuzz;
 } YacuTest;
 
+// Designates the case fields of a test table entry.
+#define YACU_CASES(table) .cases = (table), .caseSize = sizeof((table)[0]), .caseCount = sizeof(table) / sizeof((table)[0])
+
+// Whole test table entries, so that no YacuTest field is given by position.
+// Positional entries such as {"SumTest", &test_sum} leave the newer fields
+// out and warn under -Wmissing-field-initializers.
+#define YACU_TEST(testName, testFcn) {.name = (testName), .fcn = (testFcn)}
+
+#define YACU_PROPERTY_TEST(testName, testFcn, cases) {.name = (testName), .fcn = (testFcn), .propertyCases = (cases)}
+
+#define YACU_FUZZ_TEST(testName, target) {.name = (testName), .fuzz = (target)}
+
 #define END_OF_TESTS \
     {                \
-        NULL, NULL   \
+        .name = NULL \
     }
 
+// The suite fixture is set up once per process that runs the suite's
+// tests: once per run in serial mode and once per worker with --jobs. With
+// --isolated it is set up once before the tests are forked, and each test
+// process inherits a copy-on-write view of it. A failing setup fails the
+// test that needed it.
 typedef struct YacuSuite
 {
     const char *name;
     const YacuTest *tests;
+    YacuFixtureFcn setup;
+    YacuFixtureFcn teardown;
 } YacuSuite;
 
+#define YACU_SUITE(suiteName, suiteTests) {.name = (suiteName), .tests = (suiteTests)}
+
 #define END_OF_SUITES \
     {                 \
-        NULL, NULL    \
+        .name = NULL  \
     }
 
-#ifndef YACU_JUNIT_MAX_SIZE
-#define YACU_JUNIT_MAX_SIZE 1000000
+#ifndef YACU_JUNIT_BUFFER_SIZE
+#define YACU_JUNIT_BUFFER_SIZE 65536
+#endif
+
+#ifndef YACU_REPORT_QUEUE_SIZE
+#define YACU_REPORT_QUEUE_SIZE 256
+#endif
+
+// Message bytes a forked worker hands over in shared memory; longer
+// messages continue through the worker's pipe.
+#ifndef YACU_RESULT_SLOT_MESSAGE_SIZE
+#define YACU_RESULT_SLOT_MESSAGE_SIZE 4096
+#endif
+
+// Consecutive cases of a parameterized test handed to a worker at once.
+#ifndef YACU_CASE_CHUNK_SIZE
+#define YACU_CASE_CHUNK_SIZE 64
+#endif
+
+// Property cases run by one plan entry, and the number of replays spent
+// on shrinking a failing case.
+#ifndef YACU_PROPERTY_BATCH_SIZE
+#define YACU_PROPERTY_BATCH_SIZE 1000
 #endif
 
+#ifndef YACU_PROPERTY_SHRINK_LIMIT
+#define YACU_PROPERTY_SHRINK_LIMIT 2000
+#endif
+
+// Mismatches that a failed array check lists with their values.
+#ifndef YACU_ARRAY_MISMATCHES
+#define YACU_ARRAY_MISMATCHES 8
+#endif
+
+// Deprecated: messages grow as needed and have no maximum size. Kept so
+// that code which sized its own buffers with it still builds.
 #ifndef YACU_TEST_RUN_MESSAGE_MAX_SIZE
 #define YACU_TEST_RUN_MESSAGE_MAX_SIZE 100000
 #endif
 
+#ifndef YACU_BENCHMARK_MAX_REPETITIONS
+#define YACU_BENCHMARK_MAX_REPETITIONS 100
+#endif
+
+#ifndef YACU_BENCHMARK_ALPHA
+#define YACU_BENCHMARK_ALPHA 0.01
+#endif
+
+// Times are in nanoseconds per iteration. The benchmark function may set
+// bytesPerIteration or itemsPerIteration to get throughput reported. The
+// baseline fields are set when the benchmark was compared to a baseline.
+typedef struct YacuBenchmarkStats
+{
+    size_t iterations;
+    size_t repetitions;
+    double min;
+    double median;
+    double mean;
+    double p99;
+    double stddev;
+    double bytesPerIteration;
+    double itemsPerIteration;
+    double baselineMedian;
+    double change;
+    double pValue;
+    double samples[YACU_BENCHMARK_MAX_REPETITIONS];
+} YacuBenchmarkStats;
+
+// Heap usage of a test, counted when the yacualloc tracker is linked.
+// Sizes are as reported by malloc_usable_size. Frees of blocks allocated
+// before the test are counted too, so leaks are a lower bound.
+typedef struct YacuAllocStats
+{
+    size_t allocations;
+    size_t frees;
+    size_t allocatedBytes;
+    size_t freedBytes;
+    size_t peakBytes;
+    size_t leakedBytes;
+} YacuAllocStats;
+
+// Counters are deltas over the test. For isolated tests they come from
+// wait4 and cover the whole child process; maxRssKb is the high-water mark
+// of the process that ran the test.
+typedef struct YacuResourceUsage
+{
+    long maxRssKb;
+    long minorFaults;
+    long majorFaults;
+    long voluntarySwitches;
+    long involuntarySwitches;
+} YacuResourceUsage;
+
+typedef enum YacuPerfCounter
+{
+    PERF_CYCLES = 0,
+    PERF_INSTRUCTIONS,
+    PERF_BRANCH_MISSES,
+    PERF_L1D_MISSES,
+    PERF_LLC_MISSES,
+    PERF_TASK_CLOCK,
+    PERF_PAGE_FAULTS,
+    PERF_CONTEXT_SWITCHES,
+    PERF_COUNTER_COUNT
+} YacuPerfCounter;
+
+// Linux perf_event counters around the test body, or per iteration of the
+// measured benchmark repetitions. Bit i of available is set when counter i
+// could be opened; hardware counters are often denied in containers.
+typedef struct YacuPerfCounters
+{
+    unsigned available;
+    double values[PERF_COUNTER_COUNT];
+} YacuPerfCounters;
+
+struct YacuMessageArena;
+
+struct YacuProperty;
+
 typedef struct YacuTestRun
 {
     YacuStatus result;
-    char message[YACU_TEST_RUN_MESSAGE_MAX_SIZE];
+    const char *message;
+    size_t messageLength;
+    struct YacuMessageArena *arena;
     YacuReportPtr *reports;
     const void *runData;
+    void *globalState;
+    void *fixture;
+    void *testFixture;
+    const void *testCase;
+    size_t caseIndex;
+    // Corpus input a fuzz test ran on, NULL otherwise.
+    const char *inputName;
+    struct YacuProperty *property;
     const YacuSuite *suite;
     const YacuTest *test;
+    YacuJumpBuffer *abortJump;
+    double startTime;
+    double duration;
+    double userTime;
+    double systemTime;
+    double overhead;
+    YacuBenchmarkStats benchmark;
+    YacuAllocStats allocs;
+    YacuResourceUsage usage;
+    YacuPerfCounters perf;
 } YacuTestRun;
 
+#define YACU_LOG_MAGIC "YACULOG1"
+#define YACU_LOG_VERSION 1
+
+// A binary result log is a YacuLogHeader followed by records. Every record
+// starts with a YacuLogRecord whose size covers the whole record and is a
+// multiple of 8. Records are appended whole, one test at a time, and a
+// reader stops at a truncated tail, so the log of a crashed run stays
+// readable.
+typedef enum YacuLogRecordKind
+{
+    LOG_SUITE_NAME = 1,
+    LOG_TEST_NAME = 2,
+    LOG_MESSAGE = 3,
+    LOG_RESULT = 4,
+} YacuLogRecordKind;
+
+typedef struct YacuLogHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+} YacuLogHeader;
+
+typedef struct YacuLogRecord
+{
+    uint32_t kind;
+    uint32_t size;
+} YacuLogRecord;
+
+// Names and messages; the text follows, NUL terminated. Names get ids in
+// order of first use and test names refer to their suite.
+typedef struct YacuLogText
+{
+    YacuLogRecord record;
+    uint32_t id;
+    uint32_t suiteId;
+    uint64_t length;
+} YacuLogText;
+
+// The message offset is the file offset of an earlier message text.
+typedef struct YacuLogResult
+{
+    YacuLogRecord record;
+    uint32_t suiteId;
+    uint32_t testId;
+    int32_t status;
+    uint32_t reserved;
+    double startTime;
+    double duration;
+    double userTime;
+    double systemTime;
+    uint64_t messageOffset;
+    uint64_t messageLength;
+} YacuLogResult;
+
+typedef enum YacuLogFormat
+{
+    LOG_JUNIT = 0,
+    LOG_JSON_LINES,
+    LOG_SUMMARY,
+} YacuLogFormat;
+
 void yacu_apply_cmd_args(YacuOptions *options, int argc, char const *argv[]);
 
 YacuStatus yacu_execute(YacuOptions options, const YacuSuite *suites);
 
+const char *yacu_status_name(YacuStatus status);
+
+// Converts a binary result log; statusFilter keeps only the results with
+// that status name when it is not NULL.
+YacuStatus yacu_convert_log(const char *logPath, YacuLogFormat format, const char *statusFilter, FILE *output);
+
 void test_run_message_append(YacuTestRun *testRun, const char *format, ...);
 
 void yacu_assert(YacuTestRun *testRun, bool condition, const char *fmt, ...);
 
+void yacu_expect(YacuTestRun *testRun, bool condition, const char *fmt, ...);
+
+typedef void (*YacuCheckFcn)(YacuTestRun *testRun, bool condition, const char *fmt, ...);
+
+// Whole-buffer checks, compared with SSE2 or AVX2 where available. A
+// failure counts all mismatches and lists the first YACU_ARRAY_MISMATCHES
+// of them with the largest error. Doubles match within the absolute or
+// relative tolerance or within ulps units in the last place, and NaNs
+// only match NaNs.
+void yacu_check_mem(YacuCheckFcn check, YacuTestRun *testRun, const char *file, int line, const char *kind, const char *label,
+                    const void *left, const void *right, size_t size);
+
+void yacu_check_array_int(YacuCheckFcn check, YacuTestRun *testRun, const char *file, int line, const char *kind, const char *label,
+                          const int *left, const int *right, size_t count);
+
+void yacu_check_array_dbl(YacuCheckFcn check, YacuTestRun *testRun, const char *file, int line, const char *kind, const char *label,
+                          const double *left, const double *right, size_t count, double absolute, double relative, uint64_t ulps);
+
+// Inputs of property tests, shrinking toward 0 or the end of the range
+// nearest to it. Bytes and strings get a random length up to the maximum;
+// a string buffer holds maxLength + 1 characters and a NULL alphabet means
+// printable ASCII.
+int64_t yacu_draw_int(YacuTestRun *testRun, int64_t min, int64_t max);
+
+double yacu_draw_double(YacuTestRun *testRun, double min, double max);
+
+size_t yacu_draw_bytes(YacuTestRun *testRun, uint8_t *buffer, size_t maxSize);
+
+size_t yacu_draw_string(YacuTestRun *testRun, char *buffer, size_t maxLength, const char *alphabet);
+
+bool yacu_alloc_tracking();
+
+YacuProcessHandle yacu_fork();
+
+bool yacu_is_forked(YacuProcessHandle pid);
+
+YacuStatus yacu_wait_for_forked(YacuProcessHandle forkedId);
+
+YacuStatus yacu_forked_test(YacuTestFcn forkedFcn, const void *runData, char *message, size_t messageSize);
+
+#define YACU_CHECK(check, kind, testRun, condition, label, fmt, ...) \
+    check(testRun, condition, "%s:%d - " kind " %s (" fmt ") failed!", __FILE__, __LINE__, label, __VA_ARGS__)
+
 #define YACU_ASSERT(testRun, condition, label, fmt, ...) \
-    yacu_assert(testRun, condition, "%s:%d - Assertion %s (" fmt ") failed!", __FILE__, __LINE__, label, __VA_ARGS__)
+    YACU_CHECK(yacu_assert, "Assertion", testRun, condition, label, fmt, __VA_ARGS__)
+
+#define YACU_EXPECT(testRun, condition, label, fmt, ...) \
+    YACU_CHECK(yacu_expect, "Expectation", testRun, condition, label, fmt, __VA_ARGS__)
+
+#define YACU_CHECK_TRUE(CHECK, testRun, condition) \
+    CHECK(testRun, condition, #condition, "%d", condition)
+
+#define YACU_CHECK_EQ_STR(CHECK, testRun, left, right) \
+    CHECK(testRun, strcmp(left, right) == 0, #left " == " #right, "\"%s\" == \"%s\"", left, right)
+
+#define YACU_CHECK_IN_STR(CHECK, testRun, left, right) \
+    CHECK(testRun, strstr(right, left) != NULL, #left " IN " #right, "\"%s\" IN \"%s\"", left, right)
+
+#define YACU_CHECK_CMP(CHECK, testRun, leftfmt, rightfmt, left, cmp, right) \
+    CHECK(testRun, left cmp right, #left " " #cmp " " #right, leftfmt " " #cmp " " rightfmt, left, right)
+
+#define YACU_ABS(x) ((x) > 0 ? (x) : -(x))
+
+#define YACU_CHECK_APPROX_EQ(CHECK, testRun, leftfmt, rightfmt, tolfmt, left, right, tol) \
+    CHECK(testRun,                                                                        \
+          YACU_ABS((left) - (right)) < (tol),                                             \
+          "|" #left " - " #right "| < " #tol,                                             \
+          "|" leftfmt " - " rightfmt "| < " tolfmt,                                       \
+          left, right, tol)
+
+#define YACU_CHECK_MAX_ALLOCS(CHECK, testRun, n)                                       \
+    CHECK(testRun,                                                                     \
+          yacu_alloc_tracking() && (testRun)->allocs.allocations <= (size_t)(n),       \
+          "allocations <= " #n,                                                        \
+          "%zu <= %zu%s",                                                              \
+          (testRun)->allocs.allocations, (size_t)(n),                                  \
+          yacu_alloc_tracking() ? "" : ", yacualloc is not linked")
+
+#define YACU_CHECK_EQ_MEM(check, kind, testRun, left, right, size) \
+    yacu_check_mem(check, testRun, __FILE__, __LINE__, kind, #left " == " #right, left, right, size)
 
-#define YACU_ASSERT_TRUE(testRun, condition) \
-    YACU_ASSERT(testRun, condition, #condition, "%d", condition)
+#define YACU_CHECK_ARRAY_EQ_INT(check, kind, testRun, left, right, count) \
+    yacu_check_array_int(check, testRun, __FILE__, __LINE__, kind, #left " == " #right, left, right, count)
 
-#define YACU_ASSERT_EQ_STR(testRun, left, right) \
-    YACU_ASSERT(testRun, strcmp(left, right) == 0, #left " == " #right, "\"%s\" == \"%s\"", left, right)
+#define YACU_CHECK_ARRAY_APPROX_EQ_DBL(check, kind, testRun, left, right, count, absolute, relative, ulps) \
+    yacu_check_array_dbl(check, testRun, __FILE__, __LINE__, kind, #left " ~= " #right, left, right, count, absolute, relative, ulps)
 
-#define YACU_ASSERT_IN_STR(testRun, left, right) \
-    YACU_ASSERT(testRun, strstr(right, left) != NULL, #left " IN " #right, "\"%s\" IN \"%s\"", left, right)
+#define YACU_ASSERT_TRUE(testRun, condition) YACU_CHECK_TRUE(YACU_ASSERT, testRun, condition)
+#define YACU_ASSERT_EQ_STR(testRun, left, right) YACU_CHECK_EQ_STR(YACU_ASSERT, testRun, left, right)
+#define YACU_ASSERT_IN_STR(testRun, left, right) YACU_CHECK_IN_STR(YACU_ASSERT, testRun, left, right)
 
 #define YACU_ASSERT_CMP(testRun, leftfmt, rightfmt, left, cmp, right) \
-    YACU_ASSERT(testRun, left cmp right, #left " " #cmp " " #right, leftfmt " " #cmp " " rightfmt, left, right)
+    YACU_CHECK_CMP(YACU_ASSERT, testRun, leftfmt, rightfmt, left, cmp, right)
 
 #define YACU_ASSERT_CMP_INT(testRun, left, cmp, right) YACU_ASSERT_CMP(testRun, "%d", "%d", left, cmp, right)
 
@@ -167,25 +569,61 @@ void yacu_assert(YacuTestRun *testRun, bool condition, const char *fmt, ...);
 
 #define YACU_ASSERT_EQ_CHAR(testRun, left, right) YACU_ASSERT_CMP(testRun, "%c", "%c", left, ==, right)
 
-#define YACU_ABS(x) ((x) > 0 ? (x) : -(x))
-
 #define YACU_ASSERT_APPROX_EQ(testRun, leftfmt, rightfmt, tolfmt, left, right, tol) \
-    YACU_ASSERT(testRun,                                                            \
-                YACU_ABS((left) - (right)) < (tol),                                 \
-                "|" #left " - " #right "| < " #tol,                                 \
-                "|" leftfmt " - " rightfmt "| < " tolfmt,                           \
-                left, right, tol)
+    YACU_CHECK_APPROX_EQ(YACU_ASSERT, testRun, leftfmt, rightfmt, tolfmt, left, right, tol)
 
 #define YACU_ASSERT_APPROX_EQ_DBL(testRun, left, right, tol) \
     YACU_ASSERT_APPROX_EQ(testRun, "%lf", "%lf", "%lf", left, right, tol)
 
-#if defined(__unix__) || defined(UNIX) || defined(__linux__) || defined(LINUX)
-#define FORK_AVAILABLE
-typedef pid_t YacuProcessHandle;
-#include <unistd.h>
-#include <sys/wait.h>
-#else
-typedef int YacuProcessHandle;
-#endif
+#define YACU_ASSERT_MAX_ALLOCS(testRun, n) YACU_CHECK_MAX_ALLOCS(YACU_ASSERT, testRun, n)
+
+#define YACU_ASSERT_EQ_MEM(testRun, left, right, size) YACU_CHECK_EQ_MEM(yacu_assert, "Assertion", testRun, left, right, size)
+
+#define YACU_ASSERT_ARRAY_EQ_INT(testRun, left, right, count) \
+    YACU_CHECK_ARRAY_EQ_INT(yacu_assert, "Assertion", testRun, left, right, count)
+
+#define YACU_ASSERT_ARRAY_APPROX_EQ_DBL(testRun, left, right, count, absolute, relative, ulps) \
+    YACU_CHECK_ARRAY_APPROX_EQ_DBL(yacu_assert, "Assertion", testRun, left, right, count, absolute, relative, ulps)
+
+#define YACU_EXPECT_TRUE(testRun, condition) YACU_CHECK_TRUE(YACU_EXPECT, testRun, condition)
+#define YACU_EXPECT_EQ_STR(testRun, left, right) YACU_CHECK_EQ_STR(YACU_EXPECT, testRun, left, right)
+#define YACU_EXPECT_IN_STR(testRun, left, right) YACU_CHECK_IN_STR(YACU_EXPECT, testRun, left, right)
+
+#define YACU_EXPECT_CMP(testRun, leftfmt, rightfmt, left, cmp, right) \
+    YACU_CHECK_CMP(YACU_EXPECT, testRun, leftfmt, rightfmt, left, cmp, right)
+
+#define YACU_EXPECT_CMP_INT(testRun, left, cmp, right) YACU_EXPECT_CMP(testRun, "%d", "%d", left, cmp, right)
+
+#define YACU_EXPECT_LT_INT(testRun, left, right) YACU_EXPECT_CMP_INT(testRun, left, <, right)
+#define YACU_EXPECT_LE_INT(testRun, left, right) YACU_EXPECT_CMP_INT(testRun, left, <=, right)
+#define YACU_EXPECT_EQ_INT(testRun, left, right) YACU_EXPECT_CMP_INT(testRun, left, ==, right)
+#define YACU_EXPECT_GT_INT(testRun, left, right) YACU_EXPECT_CMP_INT(testRun, left, >, right)
+#define YACU_EXPECT_GE_INT(testRun, left, right) YACU_EXPECT_CMP_INT(testRun, left, >=, right)
+
+#define YACU_EXPECT_CMP_UINT(testRun, left, cmp, right) YACU_EXPECT_CMP(testRun, "%u", "%u", left, cmp, right)
+
+#define YACU_EXPECT_LT_UINT(testRun, left, right) YACU_EXPECT_CMP_UINT(testRun, left, <, right)
+#define YACU_EXPECT_LE_UINT(testRun, left, right) YACU_EXPECT_CMP_UINT(testRun, left, <=, right)
+#define YACU_EXPECT_EQ_UINT(testRun, left, right) YACU_EXPECT_CMP_UINT(testRun, left, ==, right)
+#define YACU_EXPECT_GT_UINT(testRun, left, right) YACU_EXPECT_CMP_UINT(testRun, left, >, right)
+#define YACU_EXPECT_GE_UINT(testRun, left, right) YACU_EXPECT_CMP_UINT(testRun, left, >=, right)
+
+#define YACU_EXPECT_EQ_CHAR(testRun, left, right) YACU_EXPECT_CMP(testRun, "%c", "%c", left, ==, right)
+
+#define YACU_EXPECT_APPROX_EQ(testRun, leftfmt, rightfmt, tolfmt, left, right, tol) \
+    YACU_CHECK_APPROX_EQ(YACU_EXPECT, testRun, leftfmt, rightfmt, tolfmt, left, right, tol)
+
+#define YACU_EXPECT_APPROX_EQ_DBL(testRun, left, right, tol) \
+    YACU_EXPECT_APPROX_EQ(testRun, "%lf", "%lf", "%lf", left, right, tol)
+
+#define YACU_EXPECT_MAX_ALLOCS(testRun, n) YACU_CHECK_MAX_ALLOCS(YACU_EXPECT, testRun, n)
+
+#define YACU_EXPECT_EQ_MEM(testRun, left, right, size) YACU_CHECK_EQ_MEM(yacu_expect, "Expectation", testRun, left, right, size)
+
+#define YACU_EXPECT_ARRAY_EQ_INT(testRun, left, right, count) \
+    YACU_CHECK_ARRAY_EQ_INT(yacu_expect, "Expectation", testRun, left, right, count)
+
+#define YACU_EXPECT_ARRAY_APPROX_EQ_DBL(testRun, left, right, count, absolute, relative, ulps) \
+    YACU_CHECK_ARRAY_APPROX_EQ_DBL(yacu_expect, "Expectation", testRun, left, right, count, absolute, relative, ulps)
 
 #endif // YACU_H
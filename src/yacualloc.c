@@ -0,0 +1,113 @@
+/****************************************************************************
+Yet Another C Unit (YACU) testing framework
+
+MIT License
+
+Copyright (c) 2023 Slaven Glumac
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+****************************************************************************/
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include <yacu.h>
+
+#include <malloc.h>
+
+// Linking this object replaces the allocator entry points for the whole
+// program and attributes every allocation made while a test body runs to
+// that test's YacuTestRun.allocs.
+
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t count, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+extern void __libc_free(void *ptr);
+
+extern bool yacuAllocTracking;
+extern __thread YacuAllocStats *yacuActiveAllocs;
+
+__attribute__((constructor)) static void enable_alloc_tracking()
+{
+    yacuAllocTracking = true;
+}
+
+static void track_allocation(YacuAllocStats *allocs, void *ptr)
+{
+    if (allocs == NULL || ptr == NULL)
+    {
+        return;
+    }
+    allocs->allocations++;
+    allocs->allocatedBytes += malloc_usable_size(ptr);
+    if (allocs->allocatedBytes > allocs->freedBytes && allocs->allocatedBytes - allocs->freedBytes > allocs->peakBytes)
+    {
+        allocs->peakBytes = allocs->allocatedBytes - allocs->freedBytes;
+    }
+}
+
+static void track_free(YacuAllocStats *allocs, size_t size)
+{
+    if (allocs == NULL)
+    {
+        return;
+    }
+    allocs->frees++;
+    allocs->freedBytes += size;
+}
+
+void *malloc(size_t size)
+{
+    void *ptr = __libc_malloc(size);
+    track_allocation(yacuActiveAllocs, ptr);
+    return ptr;
+}
+
+void *calloc(size_t count, size_t size)
+{
+    void *ptr = __libc_calloc(count, size);
+    track_allocation(yacuActiveAllocs, ptr);
+    return ptr;
+}
+
+void *realloc(void *ptr, size_t size)
+{
+    YacuAllocStats *allocs = yacuActiveAllocs;
+    size_t previousSize = allocs != NULL && ptr != NULL ? malloc_usable_size(ptr) : 0;
+    void *moved = __libc_realloc(ptr, size);
+    if (moved == NULL && size > 0)
+    {
+        return NULL;
+    }
+    if (ptr != NULL)
+    {
+        track_free(allocs, previousSize);
+    }
+    track_allocation(allocs, moved);
+    return moved;
+}
+
+void free(void *ptr)
+{
+    if (ptr != NULL)
+    {
+        YacuAllocStats *allocs = yacuActiveAllocs;
+        track_free(allocs, allocs != NULL ? malloc_usable_size(ptr) : 0);
+    }
+    __libc_free(ptr);
+}
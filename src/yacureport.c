@@ -0,0 +1,85 @@
+/****************************************************************************
+Yet Another C Unit (YACU) testing framework
+
+MIT License
+
+Copyright (c) 2023 Slaven Glumac
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+****************************************************************************/
+#include <yacu.h>
+
+// yacu-report [--junit | --jsonl | --summary] [--status STATUS] [--output PATH] LOG
+// converts a log written with --binary-log. The default format is the summary.
+
+int main(int argc, char const *argv[])
+{
+    YacuLogFormat format = LOG_SUMMARY;
+    const char *statusFilter = NULL;
+    const char *outputPath = NULL;
+    const char *logPath = NULL;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--junit") == 0)
+        {
+            format = LOG_JUNIT;
+        }
+        else if (strcmp(argv[i], "--jsonl") == 0)
+        {
+            format = LOG_JSON_LINES;
+        }
+        else if (strcmp(argv[i], "--summary") == 0)
+        {
+            format = LOG_SUMMARY;
+        }
+        else if (strcmp(argv[i], "--status") == 0 && i + 1 < argc)
+        {
+            statusFilter = argv[i + 1];
+            i++;
+        }
+        else if (strcmp(argv[i], "--output") == 0 && i + 1 < argc)
+        {
+            outputPath = argv[i + 1];
+            i++;
+        }
+        else if (logPath == NULL && argv[i][0] != '-')
+        {
+            logPath = argv[i];
+        }
+        else
+        {
+            return WRONG_ARGS;
+        }
+    }
+    if (logPath == NULL)
+    {
+        return WRONG_ARGS;
+    }
+    FILE *output = outputPath != NULL ? fopen(outputPath, "w") : stdout;
+    if (output == NULL)
+    {
+        return FILE_FAIL;
+    }
+    YacuStatus status = yacu_convert_log(logPath, format, statusFilter, output);
+    if (output != stdout && fclose(output) != 0)
+    {
+        return FILE_FAIL;
+    }
+    return status;
+}
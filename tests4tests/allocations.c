@@ -0,0 +1,81 @@
+#include <yacu.h>
+#include <allocations.h>
+
+static void *volatile leaked = NULL;
+
+void test_alloc_counts(YacuTestRun *testRun)
+{
+    YACU_ASSERT_TRUE(testRun, yacu_alloc_tracking());
+    void *volatile first = malloc(100);
+    void *volatile second = calloc(10, 10);
+    free(first);
+    second = realloc(second, 1000);
+    YACU_ASSERT_EQ_UINT(testRun, (unsigned)testRun->allocs.allocations, 3u);
+    YACU_ASSERT_EQ_UINT(testRun, (unsigned)testRun->allocs.frees, 2u);
+    YACU_ASSERT_GE_UINT(testRun, (unsigned)testRun->allocs.peakBytes, 1000u);
+    free(second);
+}
+
+void test_no_allocs(YacuTestRun *testRun)
+{
+    int sum = 0;
+    for (int i = 0; i < 10; i++)
+    {
+        sum += i;
+    }
+    YACU_ASSERT_EQ_INT(testRun, sum, 45);
+    YACU_ASSERT_MAX_ALLOCS(testRun, 0);
+}
+
+void test_leak(YacuTestRun *testRun)
+{
+    leaked = malloc(64);
+    YACU_ASSERT_MAX_ALLOCS(testRun, 0);
+}
+
+YacuTest forAllocations[] = {
+    {.name = "leaking", .fcn = &test_leak},
+    END_OF_TESTS};
+
+YacuSuite suites4Allocations[] = {
+    {.name = "ForAllocations", .tests = forAllocations},
+    END_OF_SUITES};
+
+typedef struct AllocReport
+{
+    YacuAllocStats allocs;
+    char message[256];
+} AllocReport;
+
+static void alloc_report_action(YacuReportState state, YacuReportEvent reportEvent, const YacuSuite *suite, const YacuTestRun *testRun)
+{
+    (void)suite;
+    AllocReport *allocReport = state;
+    if (reportEvent == TEST_RUN_FINISHED)
+    {
+        allocReport->allocs = testRun->allocs;
+        snprintf(allocReport->message, sizeof(allocReport->message), "%s", testRun->message);
+    }
+}
+
+void test_alloc_leaks(YacuTestRun *testRun)
+{
+    AllocReport allocState = {{0}, ""};
+    YacuReport allocReport = {&allocState, alloc_report_action};
+    YacuOptions options = yacu_default_options();
+    options.customReport = &allocReport;
+    options.stdoutReport = false;
+    options.cachePath = NULL;
+    YacuStatus returnCode = yacu_execute(options, suites4Allocations);
+    free(leaked);
+    YACU_ASSERT_EQ_INT(testRun, returnCode, TEST_FAILURE);
+    YACU_ASSERT_EQ_UINT(testRun, (unsigned)allocState.allocs.allocations, 1u);
+    YACU_ASSERT_GE_UINT(testRun, (unsigned)allocState.allocs.leakedBytes, 64u);
+    YACU_ASSERT_IN_STR(testRun, " - Assertion allocations <= 0 (1 <= 0) failed!", allocState.message);
+}
+
+YacuTest allocationTests[] = {
+    {.name = "countsTest", .fcn = &test_alloc_counts},
+    {.name = "noAllocsTest", .fcn = &test_no_allocs},
+    {.name = "leaksTest", .fcn = &test_alloc_leaks},
+    END_OF_TESTS};
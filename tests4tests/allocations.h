@@ -0,0 +1,8 @@
+#ifndef ALLOCATIONS_H
+#define ALLOCATIONS_H
+
+#include <yacu.h>
+
+extern YacuTest allocationTests[];
+
+#endif // ALLOCATIONS_H
@@ -1,6 +1,8 @@
 #include <yacu.h>
 #include <assertions.h>
 
+#include <math.h>
+
 void test_assert_cmp_int(YacuTestRun *testRun)
 {
     int small = -1;
@@ -44,10 +46,35 @@ void test_assert_true(YacuTestRun *testRun)
     YACU_ASSERT_TRUE(testRun, x == 1);
 }
 
+void test_assert_arrays(YacuTestRun *testRun)
+{
+    static int integers[1003];
+    static int sameIntegers[1003];
+    static double values[1003];
+    static double closeValues[1003];
+    for (int i = 0; i < 1003; i++)
+    {
+        integers[i] = sameIntegers[i] = i * 7 - 500;
+        values[i] = i * 0.25 + 1.0;
+        closeValues[i] = values[i] + 1e-9;
+    }
+    values[1001] = closeValues[1001] = NAN;
+    values[1002] = closeValues[1002] = INFINITY;
+
+    YACU_ASSERT_EQ_MEM(testRun, "some bytes", "some bytes", 10);
+    YACU_ASSERT_ARRAY_EQ_INT(testRun, integers, sameIntegers, 1003);
+    YACU_ASSERT_ARRAY_APPROX_EQ_DBL(testRun, values, closeValues, 1003, 1e-6, 0.0, 0);
+    YACU_ASSERT_ARRAY_APPROX_EQ_DBL(testRun, values, closeValues, 1003, 0.0, 1e-6, 0);
+    double one = 1.0;
+    double nextToOne = nextafter(nextafter(1.0, 2.0), 2.0);
+    YACU_ASSERT_ARRAY_APPROX_EQ_DBL(testRun, &one, &nextToOne, 1, 0.0, 0.0, 2);
+}
+
 YacuTest assertionTests[] = {
-    {"cmpIntTest", &test_assert_cmp_int},
-    {"cmpUIntTest", &test_assert_cmp_uint},
-    {"eqCharTest", &test_assert_eq_char},
-    {"eqDblTest", &test_assert_eq_dbl},
-    {"trueTest", &test_assert_true},
+    {.name = "cmpIntTest", .fcn = &test_assert_cmp_int},
+    {.name = "cmpUIntTest", .fcn = &test_assert_cmp_uint},
+    {.name = "eqCharTest", .fcn = &test_assert_eq_char},
+    {.name = "eqDblTest", .fcn = &test_assert_eq_dbl},
+    {.name = "trueTest", .fcn = &test_assert_true},
+    {.name = "arraysTest", .fcn = &test_assert_arrays},
     END_OF_TESTS};
@@ -0,0 +1,232 @@
+#include <yacu.h>
+#include <benchmarks.h>
+#include <support.h>
+
+#include <time.h>
+
+#define UNUSED(x) (void)(x)
+
+static volatile unsigned int sink;
+
+void bench_sum_bytes(YacuTestRun *testRun, size_t iterations)
+{
+    unsigned char bytes[64] = {1, 2, 3};
+    testRun->benchmark.bytesPerIteration = sizeof(bytes);
+    for (size_t i = 0; i < iterations; i++)
+    {
+        unsigned int sum = 0;
+        for (size_t j = 0; j < sizeof(bytes); j++)
+        {
+            sum += bytes[j];
+        }
+        sink = sum;
+    }
+}
+
+YacuTest forBenchmarks[] = {
+    {.name = "sumBytes", .benchmark = &bench_sum_bytes},
+    END_OF_TESTS};
+
+YacuSuite suites4Benchmarks[] = {
+    {.name = "ForBenchmarks", .tests = forBenchmarks},
+    END_OF_SUITES};
+
+static void benchmark_report_action(YacuReportState state, YacuReportEvent reportEvent, const YacuSuite *suite, const YacuTestRun *testRun)
+{
+    UNUSED(suite);
+    if (reportEvent == TEST_RUN_FINISHED)
+    {
+        *(YacuBenchmarkStats *)state = testRun->benchmark;
+    }
+}
+
+void test_benchmark_statistics(YacuTestRun *testRun)
+{
+    const char *argv[] = {"./tests", "--benchmark-time", "0.001", "--benchmark-repetitions", "5", "--jobs", "2"};
+    YacuBenchmarkStats stats;
+    YacuReport benchmarkReport = {&stats, benchmark_report_action};
+    YacuOptions options = yacu_default_options();
+    yacu_apply_cmd_args(&options, 7, argv);
+    options.customReport = &benchmarkReport;
+    YacuStatus returnCode = yacu_execute(options, suites4Benchmarks);
+    YACU_ASSERT_EQ_INT(testRun, returnCode, OK);
+    YACU_ASSERT_EQ_UINT(testRun, (unsigned)stats.repetitions, 5u);
+    YACU_ASSERT_GT_UINT(testRun, (unsigned)stats.iterations, 1u);
+    YACU_ASSERT_TRUE(testRun, stats.min > 0.0);
+    YACU_ASSERT_TRUE(testRun, stats.min <= stats.median && stats.median <= stats.p99);
+    YACU_ASSERT_TRUE(testRun, stats.min <= stats.mean && stats.mean <= stats.p99);
+    YACU_ASSERT_APPROX_EQ_DBL(testRun, stats.bytesPerIteration, 64.0, 1e-9);
+}
+
+static void perf_report_action(YacuReportState state, YacuReportEvent reportEvent, const YacuSuite *suite, const YacuTestRun *testRun)
+{
+    UNUSED(suite);
+    if (reportEvent == TEST_RUN_FINISHED)
+    {
+        *(YacuPerfCounters *)state = testRun->perf;
+    }
+}
+
+void test_benchmark_perf_counters(YacuTestRun *testRun)
+{
+    const char *argv[] = {"./tests", "--benchmark-time", "0.001", "--perf", "--jobs", "2"};
+    YacuPerfCounters perf;
+    YacuReport perfReport = {&perf, perf_report_action};
+    YacuOptions options = yacu_default_options();
+    yacu_apply_cmd_args(&options, 6, argv);
+    options.customReport = &perfReport;
+    YacuStatus returnCode = yacu_execute(options, suites4Benchmarks);
+    YACU_ASSERT_EQ_INT(testRun, returnCode, OK);
+    if (perf.available & (1u << PERF_TASK_CLOCK))
+    {
+        YACU_ASSERT_TRUE(testRun, perf.values[PERF_TASK_CLOCK] > 0.0);
+        YACU_ASSERT_TRUE(testRun, perf.values[PERF_TASK_CLOCK] < 1e6);
+    }
+    if (perf.available & (1u << PERF_INSTRUCTIONS))
+    {
+        YACU_ASSERT_TRUE(testRun, perf.values[PERF_INSTRUCTIONS] > 1.0);
+    }
+}
+
+static void spin_setup(YacuTestRun *testRun)
+{
+    UNUSED(testRun);
+    clock_t start = clock();
+    while (clock() - start < CLOCKS_PER_SEC / 20)
+    {
+        sink++;
+    }
+}
+
+static void test_quick_body(YacuTestRun *testRun)
+{
+    UNUSED(testRun);
+    sink++;
+}
+
+YacuTest forPerfSetup[] = {
+    {.name = "quickBody", .fcn = &test_quick_body, .setup = &spin_setup},
+    END_OF_TESTS};
+
+YacuSuite suites4PerfSetup[] = {
+    {.name = "ForPerfSetup", .tests = forPerfSetup},
+    END_OF_SUITES};
+
+void test_perf_counters_skip_setup(YacuTestRun *testRun)
+{
+    const char *argv[] = {"./tests", "--perf"};
+    YacuPerfCounters perf;
+    YacuReport perfReport = {&perf, perf_report_action};
+    YacuOptions options = yacu_default_options();
+    yacu_apply_cmd_args(&options, 2, argv);
+    options.stdoutReport = false;
+    options.customReport = &perfReport;
+    YacuStatus returnCode = yacu_execute(options, suites4PerfSetup);
+    YACU_ASSERT_EQ_INT(testRun, returnCode, OK);
+    // The setup spins for 50 ms of CPU time, the body for next to none.
+    if (perf.available & (1u << PERF_TASK_CLOCK))
+    {
+        YACU_ASSERT_TRUE(testRun, perf.values[PERF_TASK_CLOCK] < 1e7);
+    }
+}
+
+typedef struct BaselineReport
+{
+    YacuStatus result;
+    char message[512];
+    YacuBenchmarkStats stats;
+} BaselineReport;
+
+static void baseline_report_action(YacuReportState state, YacuReportEvent reportEvent, const YacuSuite *suite, const YacuTestRun *testRun)
+{
+    UNUSED(suite);
+    BaselineReport *baselineReport = state;
+    if (reportEvent == TEST_RUN_FINISHED)
+    {
+        baselineReport->result = testRun->result;
+        snprintf(baselineReport->message, sizeof(baselineReport->message), "%s", testRun->message);
+        baselineReport->stats = testRun->benchmark;
+    }
+}
+
+static void run_against_baseline(BaselineReport *baselineState, const char *baselineLine)
+{
+    write_file("fake.baseline", baselineLine);
+    const char *argv[] = {"./tests", "--benchmark-time", "0.001", "--benchmark-baseline", "fake.baseline"};
+    YacuReport baselineReport = {baselineState, baseline_report_action};
+    YacuOptions options = yacu_default_options();
+    yacu_apply_cmd_args(&options, 5, argv);
+    options.customReport = &baselineReport;
+    yacu_execute(options, suites4Benchmarks);
+    remove("fake.baseline");
+}
+
+void test_benchmark_baseline(YacuTestRun *testRun)
+{
+    remove("saved.baseline");
+    const char *argv[] = {"./tests", "--benchmark-time", "0.001", "--benchmark-repetitions", "5",
+                          "--save-benchmark-baseline", "saved.baseline"};
+    YacuOptions options = yacu_default_options();
+    yacu_apply_cmd_args(&options, 7, argv);
+    YacuStatus returnCode = yacu_execute(options, suites4Benchmarks);
+    YACU_ASSERT_EQ_INT(testRun, returnCode, OK);
+    char content[4096];
+    read_file("saved.baseline", content, sizeof(content));
+    YACU_ASSERT_IN_STR(testRun, "ForBenchmarks.sumBytes\t5\t", content);
+    remove("saved.baseline");
+
+    BaselineReport baselineState = {OK, "", {0}};
+    run_against_baseline(&baselineState, "ForBenchmarks.sumBytes\t5\t0.01\t0.01\t0.011\t0.01\t0.01\n");
+    YACU_ASSERT_EQ_INT(testRun, baselineState.result, TEST_FAILURE);
+    YACU_ASSERT_IN_STR(testRun, "Benchmark regressed: median ", baselineState.message);
+    YACU_ASSERT_TRUE(testRun, baselineState.stats.pValue < 0.01);
+
+    run_against_baseline(&baselineState, "ForBenchmarks.sumBytes\t5\t1e6\t1e6\t1e6\t1e6\t1e6\n");
+    YACU_ASSERT_EQ_INT(testRun, baselineState.result, OK);
+    YACU_ASSERT_IN_STR(testRun, "Benchmark improved: median ", baselineState.message);
+    YACU_ASSERT_APPROX_EQ_DBL(testRun, baselineState.stats.baselineMedian, 1e6, 1e-6);
+}
+
+void test_wrong_benchmark_args(YacuTestRun *testRun)
+{
+    YacuProcessHandle pid = yacu_fork();
+    if (yacu_is_forked(pid))
+    {
+        const char *argv[] = {"./tests", "--benchmark-time", "-1"};
+        YacuOptions options = yacu_default_options();
+        yacu_apply_cmd_args(&options, 3, argv);
+        UNUSED(options);
+    }
+    else
+    {
+        YacuStatus returnCode = yacu_wait_for_forked(pid);
+        YACU_ASSERT_EQ_INT(testRun, returnCode, WRONG_ARGS);
+    }
+}
+
+void test_baseline_creation_fail(YacuTestRun *testRun)
+{
+    YacuProcessHandle pid = yacu_fork();
+    if (yacu_is_forked(pid))
+    {
+        const char *argv[] = {"./tests", "--benchmark-time", "0.001", "--benchmark-repetitions", "5",
+                              "--save-benchmark-baseline", "nonexistingdir/saved.baseline"};
+        YacuOptions options = yacu_default_options();
+        yacu_apply_cmd_args(&options, 7, argv);
+        yacu_execute(options, suites4Benchmarks);
+    }
+    else
+    {
+        YacuStatus returnCode = yacu_wait_for_forked(pid);
+        YACU_ASSERT_EQ_INT(testRun, returnCode, FILE_FAIL);
+    }
+}
+
+YacuTest benchmarkTests[] = {
+    {.name = "StatisticsTest", .fcn = &test_benchmark_statistics},
+    {.name = "PerfCountersTest", .fcn = &test_benchmark_perf_counters},
+    {.name = "PerfCountersSkipSetupTest", .fcn = &test_perf_counters_skip_setup},
+    {.name = "BaselineTest", .fcn = &test_benchmark_baseline},
+    {.name = "BaselineCreationFailTest", .fcn = &test_baseline_creation_fail},
+    {.name = "WrongBenchmarkArgs", .fcn = &test_wrong_benchmark_args},
+    END_OF_TESTS};
@@ -0,0 +1,8 @@
+#ifndef BENCHMARKS_H
+#define BENCHMARKS_H
+
+#include <yacu.h>
+
+extern YacuTest benchmarkTests[];
+
+#endif // BENCHMARKS_H
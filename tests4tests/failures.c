@@ -1,6 +1,9 @@
 #include <yacu.h>
 #include <failures.h>
-#include <common.h>
+
+#include <math.h>
+
+#define FAILURE_MESSAGE_SIZE 4096
 
 void forked_assert_failed_cmp_int(YacuTestRun *forkedTestRun)
 {
@@ -11,15 +14,101 @@ void forked_assert_failed_cmp_int(YacuTestRun *forkedTestRun)
 
 void test_assert_failed_cmp_int(YacuTestRun *testRun)
 {
-    const char reportPath[] = "failedCmpIntTest.log";
-    char failureMessage[YACU_TEST_RUN_MESSAGE_MAX_SIZE];
-    YacuStatus status = forked_test(
-        testRun, reportPath, forked_assert_failed_cmp_int, failureMessage);
+    char failureMessage[FAILURE_MESSAGE_SIZE];
+    YacuStatus status = yacu_forked_test(
+        forked_assert_failed_cmp_int, testRun->runData, failureMessage, sizeof(failureMessage));
     YACU_ASSERT_EQ_INT(testRun, status, TEST_FAILURE);
     YACU_ASSERT_IN_STR(testRun, "failures.c:", failureMessage);
     YACU_ASSERT_IN_STR(testRun, " - Assertion small < -2 (-1 < -2) failed!", failureMessage);
 }
 
+void forked_expect_failed(YacuTestRun *forkedTestRun)
+{
+    int small = -1;
+
+    YACU_EXPECT_LT_INT(forkedTestRun, small, -2);
+    YACU_EXPECT_TRUE(forkedTestRun, small < 0);
+    YACU_EXPECT_EQ_STR(forkedTestRun, "left", "right");
+    test_run_message_append(forkedTestRun, "|reached");
+}
+
+void test_expect_failed(YacuTestRun *testRun)
+{
+    char failureMessage[FAILURE_MESSAGE_SIZE];
+    YacuStatus status = yacu_forked_test(
+        forked_expect_failed, testRun->runData, failureMessage, sizeof(failureMessage));
+    YACU_ASSERT_EQ_INT(testRun, status, TEST_FAILURE);
+    YACU_ASSERT_IN_STR(testRun, " - Expectation small < -2 (-1 < -2) failed!\n", failureMessage);
+    YACU_ASSERT_IN_STR(testRun, " - Expectation \"left\" == \"right\" (\"left\" == \"right\") failed!|reached", failureMessage);
+    YACU_ASSERT_TRUE(testRun, strstr(failureMessage, "small < 0") == NULL);
+}
+
+void forked_long_message(YacuTestRun *forkedTestRun)
+{
+    test_run_message_append(forkedTestRun, "first line\nsecond line\n");
+    for (int i = 0; i < 100; i++)
+    {
+        test_run_message_append(forkedTestRun, "%s", "0123456789");
+    }
+    forkedTestRun->result = TEST_ERROR;
+}
+
+void test_forked_message(YacuTestRun *testRun)
+{
+    char failureMessage[64];
+    YacuStatus status = yacu_forked_test(
+        forked_long_message, testRun->runData, failureMessage, sizeof(failureMessage));
+    YACU_ASSERT_EQ_INT(testRun, status, TEST_ERROR);
+    YACU_ASSERT_EQ_UINT(testRun, (unsigned)strlen(failureMessage), (unsigned)sizeof(failureMessage) - 1);
+    YACU_ASSERT_IN_STR(testRun, "first line\nsecond line\n0123456789", failureMessage);
+}
+
+void forked_arrays_failed(YacuTestRun *forkedTestRun)
+{
+    static double values[100000];
+    static double results[100000];
+    for (int i = 0; i < 100000; i++)
+    {
+        values[i] = results[i] = i;
+    }
+    for (int i = 10; i < 100000; i += 1000)
+    {
+        results[i] += 0.5;
+    }
+    results[77010] += 2.0;
+    int small[] = {1, 2, 3};
+    int other[] = {1, 5, 3};
+    double one = 1.0;
+    double nextToOne = nextafter(nextafter(1.0, 2.0), 2.0);
+
+    YACU_EXPECT_EQ_MEM(forkedTestRun, "abcd", "abed", 4);
+    YACU_EXPECT_ARRAY_EQ_INT(forkedTestRun, small, other, 3);
+    YACU_EXPECT_ARRAY_APPROX_EQ_DBL(forkedTestRun, &one, &nextToOne, 1, 0.0, 0.0, 1);
+    YACU_ASSERT_ARRAY_APPROX_EQ_DBL(forkedTestRun, values, results, 100000, 0.1, 0.0, 0);
+}
+
+void test_arrays_failed(YacuTestRun *testRun)
+{
+    char failureMessage[FAILURE_MESSAGE_SIZE];
+    YacuStatus status = yacu_forked_test(
+        forked_arrays_failed, testRun->runData, failureMessage, sizeof(failureMessage));
+    YACU_ASSERT_EQ_INT(testRun, status, TEST_FAILURE);
+    YACU_ASSERT_IN_STR(testRun, " - Expectation \"abcd\" == \"abed\" (1 of 4 bytes differ, max error 2 at [2]: [2] 63 != 65) failed!\n",
+                       failureMessage);
+    YACU_ASSERT_IN_STR(testRun, " - Expectation small == other (1 of 3 elements differ, max error 3 at [1]: [1] 2 != 5) failed!\n",
+                       failureMessage);
+    YACU_ASSERT_IN_STR(testRun, " - Expectation &one ~= &nextToOne (1 of 1 elements differ, max error 4.4408920985006262e-16 at [0]: "
+                                "[0] 1 != 1.0000000000000004) failed!\n",
+                       failureMessage);
+    YACU_ASSERT_IN_STR(testRun, " - Assertion values ~= results (100 of 100000 elements differ, max error 2.5 at [77010]: "
+                                "[10] 10 != 10.5, [1010] 1010 != 1010.5, [2010] 2010 != 2010.5, [3010] 3010 != 3010.5, "
+                                "[4010] 4010 != 4010.5, [5010] 5010 != 5010.5, [6010] 6010 != 6010.5, [7010] 7010 != 7010.5 ...) failed!",
+                       failureMessage);
+}
+
 YacuTest assertionFailuresTests[] = {
-    {"failedCmpIntTest", &test_assert_failed_cmp_int},
+    {.name = "failedCmpIntTest", .fcn = &test_assert_failed_cmp_int},
+    {.name = "failedExpectTest", .fcn = &test_expect_failed},
+    {.name = "forkedMessageTest", .fcn = &test_forked_message},
+    {.name = "failedArraysTest", .fcn = &test_arrays_failed},
     END_OF_TESTS};
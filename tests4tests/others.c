@@ -1,6 +1,9 @@
 #include <yacu.h>
 #include <others.h>
-#include <common.h>
+#include <support.h>
+
+#include <pthread.h>
+#include <signal.h>
 
 #define UNUSED(x) (void)(x)
 
@@ -11,11 +14,11 @@ void test_simple_eq_int(YacuTestRun *testRun)
 }
 
 YacuTest forOthers[] = {
-    {"simpleEqInt", &test_simple_eq_int},
+    YACU_TEST("simpleEqInt", &test_simple_eq_int),
     END_OF_TESTS};
 
 YacuSuite suites4Others[] = {
-    {"ForOthers", forOthers},
+    YACU_SUITE("ForOthers", forOthers),
     END_OF_SUITES};
 
 void test_run_single_test(YacuTestRun *testRun)
@@ -39,7 +42,7 @@ void test_run_single_suite(YacuTestRun *testRun)
 void test_wrong_args(YacuTestRun *testRun)
 {
     YacuProcessHandle pid = yacu_fork();
-    if (is_forked(pid))
+    if (yacu_is_forked(pid))
     {
         const char *argv[] = {"./tests", "--wrong-args"};
         YacuOptions options = yacu_default_options();
@@ -48,7 +51,7 @@ void test_wrong_args(YacuTestRun *testRun)
     }
     else
     {
-        YacuStatus returnCode = wait_for_forked(pid);
+        YacuStatus returnCode = yacu_wait_for_forked(pid);
         YACU_ASSERT_EQ_INT(testRun, returnCode, WRONG_ARGS);
     }
 }
@@ -56,7 +59,7 @@ void test_wrong_args(YacuTestRun *testRun)
 void test_missing_test_args(YacuTestRun *testRun)
 {
     YacuProcessHandle pid = yacu_fork();
-    if (is_forked(pid))
+    if (yacu_is_forked(pid))
     {
         const char *argv[] = {"./tests", "--test"};
         YacuOptions options = yacu_default_options();
@@ -65,7 +68,7 @@ void test_missing_test_args(YacuTestRun *testRun)
     }
     else
     {
-        YacuStatus returnCode = wait_for_forked(pid);
+        YacuStatus returnCode = yacu_wait_for_forked(pid);
         YACU_ASSERT_EQ_INT(testRun, returnCode, WRONG_ARGS);
     }
 }
@@ -73,7 +76,7 @@ void test_missing_test_args(YacuTestRun *testRun)
 void test_missing_junit_args(YacuTestRun *testRun)
 {
     YacuProcessHandle pid = yacu_fork();
-    if (is_forked(pid))
+    if (yacu_is_forked(pid))
     {
         const char *argv[] = {"./tests", "--junit"};
         YacuOptions options = yacu_default_options();
@@ -82,7 +85,7 @@ void test_missing_junit_args(YacuTestRun *testRun)
     }
     else
     {
-        YacuStatus returnCode = wait_for_forked(pid);
+        YacuStatus returnCode = yacu_wait_for_forked(pid);
         YACU_ASSERT_EQ_INT(testRun, returnCode, WRONG_ARGS);
     }
 }
@@ -90,7 +93,7 @@ void test_missing_junit_args(YacuTestRun *testRun)
 void test_junit_creation_fail(YacuTestRun *testRun)
 {
     YacuProcessHandle pid = yacu_fork();
-    if (is_forked(pid))
+    if (yacu_is_forked(pid))
     {
         const char *argv[] = {"./tests", "--junit", "nonexistingdir/report.xml"};
         YacuOptions options = yacu_default_options();
@@ -99,7 +102,7 @@ void test_junit_creation_fail(YacuTestRun *testRun)
     }
     else
     {
-        YacuStatus returnCode = wait_for_forked(pid);
+        YacuStatus returnCode = yacu_wait_for_forked(pid);
         YACU_ASSERT_EQ_INT(testRun, returnCode, FILE_FAIL);
     }
 }
@@ -111,6 +114,7 @@ void test_junit_creation(YacuTestRun *testRun)
     yacu_apply_cmd_args(&options, 3, argv);
     YacuStatus returnCode = yacu_execute(options, suites4Others);
     YACU_ASSERT_EQ_INT(testRun, returnCode, OK);
+    remove("success.xml");
 }
 
 void test_run_single_suite_with_fork(YacuTestRun *testRun)
@@ -122,13 +126,1000 @@ void test_run_single_suite_with_fork(YacuTestRun *testRun)
     YACU_ASSERT_EQ_INT(testRun, returnCode, OK);
 }
 
+void test_fail_cmp_int(YacuTestRun *testRun)
+{
+    int x = 1;
+    YACU_ASSERT_EQ_INT(testRun, x, 2);
+}
+
+YacuTest forParallel[] = {
+    {.name = "first", .fcn = &test_simple_eq_int},
+    {.name = "failing", .fcn = &test_fail_cmp_int},
+    {.name = "third", .fcn = &test_simple_eq_int},
+    {.name = "fourth", .fcn = &test_simple_eq_int},
+    END_OF_TESTS};
+
+YacuSuite suites4Parallel[] = {
+    {.name = "ForOthers", .tests = forOthers},
+    {.name = "ForParallel", .tests = forParallel},
+    END_OF_SUITES};
+
+typedef struct OrderReport
+{
+    char order[256];
+} OrderReport;
+
+static void order_report_action(YacuReportState state, YacuReportEvent reportEvent, const YacuSuite *suite, const YacuTestRun *testRun)
+{
+    OrderReport *orderReport = state;
+    size_t length = strlen(orderReport->order);
+    switch (reportEvent)
+    {
+    case SUITE_STARTED:
+        snprintf(orderReport->order + length, sizeof(orderReport->order) - length, "[%s", suite->name);
+        break;
+    case TEST_RUN_FINISHED:
+        snprintf(orderReport->order + length, sizeof(orderReport->order) - length, " %s:%d", testRun->test->name, testRun->result);
+        break;
+    case SUITE_FINISHED:
+        snprintf(orderReport->order + length, sizeof(orderReport->order) - length, "]");
+        break;
+    default:
+        break;
+    }
+}
+
+void test_run_parallel(YacuTestRun *testRun)
+{
+    const char *argv[] = {"./tests", "--jobs", "3"};
+    OrderReport orderState = {""};
+    YacuReport orderReport = {&orderState, order_report_action};
+    YacuOptions options = yacu_default_options();
+    yacu_apply_cmd_args(&options, 3, argv);
+    options.customReport = &orderReport;
+    YacuStatus returnCode = yacu_execute(options, suites4Parallel);
+    YACU_ASSERT_EQ_INT(testRun, returnCode, TEST_FAILURE);
+    YACU_ASSERT_EQ_STR(testRun, orderState.order,
+                       "[ForOthers simpleEqInt:0][ForParallel first:0 failing:1 third:0 fourth:0]");
+}
+
+void test_run_serial_abort(YacuTestRun *testRun)
+{
+    OrderReport orderState = {""};
+    YacuReport orderReport = {&orderState, order_report_action};
+    YacuOptions options = yacu_default_options();
+    options.customReport = &orderReport;
+    YacuStatus returnCode = yacu_execute(options, suites4Parallel);
+    YACU_ASSERT_EQ_INT(testRun, returnCode, TEST_FAILURE);
+    YACU_ASSERT_EQ_STR(testRun, orderState.order,
+                       "[ForOthers simpleEqInt:0][ForParallel first:0 failing:1 third:0 fourth:0]");
+}
+
+void test_junit_counts(YacuTestRun *testRun)
+{
+    const char *argv[] = {"./tests", "--jobs", "2", "--junit", "counts.xml"};
+    YacuOptions options = yacu_default_options();
+    yacu_apply_cmd_args(&options, 5, argv);
+    YacuStatus returnCode = yacu_execute(options, suites4Parallel);
+    YACU_ASSERT_EQ_INT(testRun, returnCode, TEST_FAILURE);
+    char content[16384];
+    read_file("counts.xml", content, sizeof(content));
+    YACU_ASSERT_IN_STR(testRun, "name=\"ForParallel\" ", content);
+    YACU_ASSERT_IN_STR(testRun, " tests=\"4\" failures=\"1\" errors=\"0\" time=\"", content);
+    YACU_ASSERT_IN_STR(testRun, "<failure type=\"FAILURE\" message=\"", content);
+    YACU_ASSERT_IN_STR(testRun, "</testsuite>\n</testsuites>\n", content);
+    remove("counts.xml");
+}
+
+void test_exit_midway(YacuTestRun *testRun)
+{
+    UNUSED(testRun);
+    _exit(OK);
+}
+
+YacuTest forJUnitPartial[] = {
+    {.name = "first", .fcn = &test_simple_eq_int},
+    {.name = "exiting", .fcn = &test_exit_midway},
+    {.name = "never", .fcn = &test_simple_eq_int},
+    END_OF_TESTS};
+
+YacuSuite suites4JUnitPartial[] = {
+    {.name = "ForOthers", .tests = forOthers},
+    {.name = "ForJUnitPartial", .tests = forJUnitPartial},
+    END_OF_SUITES};
+
+void test_junit_partial(YacuTestRun *testRun)
+{
+    YacuProcessHandle pid = yacu_fork();
+    if (yacu_is_forked(pid))
+    {
+        const char *argv[] = {"./tests", "--junit", "partial.xml"};
+        YacuOptions options = yacu_default_options();
+        yacu_apply_cmd_args(&options, 3, argv);
+        yacu_execute(options, suites4JUnitPartial);
+    }
+    else
+    {
+        yacu_wait_for_forked(pid);
+        char content[16384];
+        read_file("partial.xml", content, sizeof(content));
+        YACU_ASSERT_IN_STR(testRun, "name=\"ForOthers\" ", content);
+        YACU_ASSERT_IN_STR(testRun, " tests=\"1\" failures=\"0\" errors=\"0\" time=\"", content);
+        YACU_ASSERT_IN_STR(testRun, "name=\"ForJUnitPartial\" ", content);
+        YACU_ASSERT_IN_STR(testRun, "  </testsuite>\n</testsuites>\n", content);
+        remove("partial.xml");
+    }
+}
+
+void test_long_message(YacuTestRun *testRun)
+{
+    for (int i = 0; i < 15000; i++)
+    {
+        test_run_message_append(testRun, "%s", "0123456789");
+    }
+}
+
+YacuTest forMessages[] = {
+    {.name = "long", .fcn = &test_long_message},
+    {.name = "empty", .fcn = &test_simple_eq_int},
+    END_OF_TESTS};
+
+YacuSuite suites4Messages[] = {
+    {.name = "ForMessages", .tests = forMessages},
+    END_OF_SUITES};
+
+static void message_report_action(YacuReportState state, YacuReportEvent reportEvent, const YacuSuite *suite, const YacuTestRun *testRun)
+{
+    UNUSED(suite);
+    size_t *lengths = state;
+    if (reportEvent == TEST_RUN_FINISHED)
+    {
+        size_t index = strcmp(testRun->test->name, "long") == 0 ? 0 : 1;
+        lengths[index] = testRun->messageLength == strlen(testRun->message) ? testRun->messageLength : 0;
+    }
+}
+
+void test_run_message_lengths(YacuTestRun *testRun)
+{
+    const char *argv[] = {"./tests", "--jobs", "2"};
+    for (int argc = 1; argc <= 3; argc += 2)
+    {
+        size_t lengths[2] = {1, 1};
+        YacuReport messageReport = {lengths, message_report_action};
+        YacuOptions options = yacu_default_options();
+        yacu_apply_cmd_args(&options, argc, argv);
+        options.stdoutReport = false;
+        options.customReport = &messageReport;
+        yacu_execute(options, suites4Messages);
+        YACU_ASSERT_EQ_UINT(testRun, (unsigned)lengths[0], 150000u);
+        YACU_ASSERT_EQ_UINT(testRun, (unsigned)lengths[1], 0u);
+    }
+}
+
+void test_crash(YacuTestRun *testRun)
+{
+    UNUSED(testRun);
+    raise(SIGSEGV);
+}
+
+YacuTest forIsolated[] = {
+    {.name = "failing", .fcn = &test_fail_cmp_int},
+    {.name = "crashing", .fcn = &test_crash},
+    {.name = "last", .fcn = &test_simple_eq_int},
+    END_OF_TESTS};
+
+YacuSuite suites4Isolated[] = {
+    {.name = "ForIsolated", .tests = forIsolated},
+    END_OF_SUITES};
+
+void test_run_isolated(YacuTestRun *testRun)
+{
+    const char *argv[] = {"./tests", "--isolated"};
+    OrderReport orderState = {""};
+    YacuReport orderReport = {&orderState, order_report_action};
+    YacuOptions options = yacu_default_options();
+    yacu_apply_cmd_args(&options, 2, argv);
+    options.customReport = &orderReport;
+    YacuStatus returnCode = yacu_execute(options, suites4Isolated);
+    YACU_ASSERT_EQ_INT(testRun, returnCode, TEST_FAILURE);
+    YACU_ASSERT_EQ_STR(testRun, orderState.order, "[ForIsolated failing:1 crashing:5 last:0]");
+}
+
+static int globalSetupCalls = 0;
+static int globalTeardownCalls = 0;
+
+static void *count_global_setup(const void *runData)
+{
+    UNUSED(runData);
+    globalSetupCalls++;
+    int *answer = malloc(sizeof(int));
+    if (answer != NULL)
+    {
+        *answer = 42;
+    }
+    return answer;
+}
+
+static void count_global_teardown(const void *runData, void *globalState)
+{
+    UNUSED(runData);
+    globalTeardownCalls += globalState != NULL && *(int *)globalState == 42;
+    free(globalState);
+}
+
+void test_global_setup_done(YacuTestRun *testRun)
+{
+    YACU_ASSERT_EQ_INT(testRun, globalSetupCalls, 1);
+    YACU_ASSERT_TRUE(testRun, testRun->globalState != NULL);
+    YACU_ASSERT_EQ_INT(testRun, *(int *)testRun->globalState, 42);
+}
+
+YacuTest forForkServer[] = {
+    {.name = "setupDone", .fcn = &test_global_setup_done},
+    {.name = "setupStillDone", .fcn = &test_global_setup_done},
+    END_OF_TESTS};
+
+YacuSuite suites4ForkServer[] = {
+    {.name = "ForForkServer", .tests = forForkServer},
+    END_OF_SUITES};
+
+static void overhead_report_action(YacuReportState state, YacuReportEvent reportEvent, const YacuSuite *suite, const YacuTestRun *testRun)
+{
+    UNUSED(suite);
+    bool *allMeasured = state;
+    if (reportEvent == TEST_RUN_FINISHED)
+    {
+        *allMeasured = *allMeasured && testRun->overhead > 0.0 && testRun->duration >= 0.0;
+    }
+}
+
+void test_run_fork_server(YacuTestRun *testRun)
+{
+    const char *argv[] = {"./tests", "--isolated"};
+    bool allMeasured = true;
+    YacuReport overheadReport = {&allMeasured, overhead_report_action};
+    YacuOptions options = yacu_default_options();
+    yacu_apply_cmd_args(&options, 2, argv);
+    options.customReport = &overheadReport;
+    options.globalSetup = count_global_setup;
+    options.globalTeardown = count_global_teardown;
+    YacuStatus returnCode = yacu_execute(options, suites4ForkServer);
+    YACU_ASSERT_EQ_INT(testRun, returnCode, OK);
+    YACU_ASSERT_EQ_INT(testRun, globalSetupCalls, 1);
+    YACU_ASSERT_EQ_INT(testRun, globalTeardownCalls, 1);
+    YACU_ASSERT_TRUE(testRun, allMeasured);
+}
+
+typedef struct TimingReport
+{
+    int suitesTimed;
+    bool testingTimed;
+} TimingReport;
+
+static void timing_report_action(YacuReportState state, YacuReportEvent reportEvent, const YacuSuite *suite, const YacuTestRun *testRun)
+{
+    UNUSED(suite);
+    TimingReport *timing = state;
+    if (reportEvent == SUITE_FINISHED && testRun != NULL && testRun->test == NULL && testRun->duration >= 0.0)
+    {
+        timing->suitesTimed++;
+    }
+    else if (reportEvent == TESTING_FINISHED && testRun != NULL && testRun->duration > 0.0)
+    {
+        timing->testingTimed = true;
+    }
+}
+
+void test_run_timed(YacuTestRun *testRun)
+{
+    const char *argv[] = {"./tests", "--slowest", "2"};
+    TimingReport timing = {0, false};
+    YacuReport timingReport = {&timing, timing_report_action};
+    YacuOptions options = yacu_default_options();
+    yacu_apply_cmd_args(&options, 3, argv);
+    options.customReport = &timingReport;
+    YacuStatus returnCode = yacu_execute(options, suites4Others);
+    YACU_ASSERT_EQ_INT(testRun, returnCode, OK);
+    YACU_ASSERT_EQ_UINT(testRun, (unsigned)options.slowest, 2u);
+    YACU_ASSERT_EQ_INT(testRun, timing.suitesTimed, 1);
+    YACU_ASSERT_TRUE(testRun, timing.testingTimed);
+}
+
+void test_hang(YacuTestRun *testRun)
+{
+    UNUSED(testRun);
+    for (;;)
+    {
+        pause();
+    }
+}
+
+YacuTest forTimeout[] = {
+    {.name = "hanging", .fcn = &test_hang},
+    {.name = "limited", .fcn = &test_hang, .timeout = 0.05},
+    {.name = "after", .fcn = &test_simple_eq_int},
+    END_OF_TESTS};
+
+YacuSuite suites4Timeout[] = {
+    {.name = "ForTimeout", .tests = forTimeout},
+    END_OF_SUITES};
+
+void test_run_timeout(YacuTestRun *testRun)
+{
+    const char *argv[] = {"./tests", "--timeout", "0.1", "--jobs", "2", "--junit", "timeout.xml"};
+    OrderReport orderState = {""};
+    YacuReport orderReport = {&orderState, order_report_action};
+    YacuOptions options = yacu_default_options();
+    yacu_apply_cmd_args(&options, 7, argv);
+    options.customReport = &orderReport;
+    YacuStatus returnCode = yacu_execute(options, suites4Timeout);
+    YACU_ASSERT_EQ_INT(testRun, returnCode, TEST_TIMEOUT);
+    YACU_ASSERT_EQ_STR(testRun, orderState.order, "[ForTimeout hanging:6 limited:6 after:0]");
+    char content[16384];
+    read_file("timeout.xml", content, sizeof(content));
+    YACU_ASSERT_IN_STR(testRun, "<error type=\"TIMEOUT\" message=\"Test timed out after 0.100 s\"/>", content);
+    YACU_ASSERT_IN_STR(testRun, "<error type=\"TIMEOUT\" message=\"Test timed out after 0.050 s\"/>", content);
+    remove("timeout.xml");
+}
+
+void test_run_timeout_override(YacuTestRun *testRun)
+{
+    const char *argv[] = {"./tests", "--test", "ForTimeout", "limited"};
+    OrderReport orderState = {""};
+    YacuReport orderReport = {&orderState, order_report_action};
+    YacuOptions options = yacu_default_options();
+    yacu_apply_cmd_args(&options, 4, argv);
+    options.customReport = &orderReport;
+    YacuStatus returnCode = yacu_execute(options, suites4Timeout);
+    YACU_ASSERT_EQ_INT(testRun, returnCode, TEST_TIMEOUT);
+    YACU_ASSERT_EQ_STR(testRun, orderState.order, "[ForTimeout limited:6]");
+}
+
+static void run_selection(YacuTestRun *testRun, int argc, const char *argv[], const char *expectedOrder)
+{
+    OrderReport orderState = {""};
+    YacuReport orderReport = {&orderState, order_report_action};
+    YacuOptions options = yacu_default_options();
+    yacu_apply_cmd_args(&options, argc, argv);
+    options.customReport = &orderReport;
+    yacu_execute(options, suites4Parallel);
+    YACU_ASSERT_EQ_STR(testRun, orderState.order, expectedOrder);
+}
+
+void test_run_shards(YacuTestRun *testRun)
+{
+    const char *firstArgv[] = {"./tests", "--shard", "1/2"};
+    run_selection(testRun, 3, firstArgv, "[ForOthers simpleEqInt:0][ForParallel failing:1 fourth:0]");
+    const char *secondArgv[] = {"./tests", "--shard", "2/2"};
+    run_selection(testRun, 3, secondArgv, "[ForParallel first:0 third:0]");
+    const char *suiteArgv[] = {"./tests", "--suite", "ForParallel", "--shard", "2/2"};
+    run_selection(testRun, 5, suiteArgv, "[ForParallel failing:1 fourth:0]");
+}
+
+void test_run_filters(YacuTestRun *testRun)
+{
+    const char *globArgv[] = {"./tests", "--filter", "ForParallel.*,-*.f*"};
+    run_selection(testRun, 3, globArgv, "[ForParallel third:0]");
+    const char *exactArgv[] = {"./tests", "--filter", "ForOthers.simpleEqInt, ForParallel.fourth"};
+    run_selection(testRun, 3, exactArgv, "[ForOthers simpleEqInt:0][ForParallel fourth:0]");
+    const char *negativeArgv[] = {"./tests", "--filter", "-ForParallel.failing"};
+    run_selection(testRun, 3, negativeArgv, "[ForOthers simpleEqInt:0][ForParallel first:0 third:0 fourth:0]");
+    const char *suiteGlobsArgv[] = {"./tests", "--filter", "ForOthers.simple*,ForParallel.th*,For?arallel.*th,-ForParallel.fi*,Missing.*"};
+    run_selection(testRun, 3, suiteGlobsArgv, "[ForOthers simpleEqInt:0][ForParallel third:0 fourth:0]");
+}
+
+void test_run_filter_file(YacuTestRun *testRun)
+{
+    write_file("filter.txt", "# rerun\nForParallel.third\n\nForParallel.first\r\nForParallel.f?ur*\n-ForParallel.first\n");
+    const char *argv[] = {"./tests", "--filter-file", "filter.txt", "--suite", "ForParallel"};
+    run_selection(testRun, 5, argv, "[ForParallel third:0 fourth:0]");
+    remove("filter.txt");
+}
+
+void test_missing_filter_file(YacuTestRun *testRun)
+{
+    YacuProcessHandle pid = yacu_fork();
+    if (yacu_is_forked(pid))
+    {
+        const char *argv[] = {"./tests", "--filter-file", "missing/filter.txt"};
+        YacuOptions options = yacu_default_options();
+        yacu_apply_cmd_args(&options, 3, argv);
+        yacu_execute(options, suites4Parallel);
+    }
+    else
+    {
+        YacuStatus returnCode = yacu_wait_for_forked(pid);
+        YACU_ASSERT_EQ_INT(testRun, returnCode, FILE_FAIL);
+    }
+}
+
+void test_nap(YacuTestRun *testRun)
+{
+    UNUSED(testRun);
+    usleep(20000);
+}
+
+YacuTest forSchedule[] = {
+    {.name = "short1", .fcn = &test_nap},
+    {.name = "short2", .fcn = &test_nap},
+    {.name = "long", .fcn = &test_nap},
+    END_OF_TESTS};
+
+YacuSuite suites4Schedule[] = {
+    {.name = "ForSchedule", .tests = forSchedule},
+    END_OF_SUITES};
+
+static const int napCases[] = {0, 1};
+
+YacuTest forCaseSchedule[] = {
+    {.name = "long", .fcn = &test_nap},
+    {.name = "param", .fcn = &test_nap, YACU_CASES(napCases)},
+    {.name = "short1", .fcn = &test_nap},
+    {.name = "short2", .fcn = &test_nap},
+    END_OF_TESTS};
+
+YacuSuite suites4CaseSchedule[] = {
+    {.name = "ForCaseSchedule", .tests = forCaseSchedule},
+    END_OF_SUITES};
+
+typedef struct StartReport
+{
+    double longStart;
+    double short2Start;
+} StartReport;
+
+static void start_report_action(YacuReportState state, YacuReportEvent reportEvent, const YacuSuite *suite, const YacuTestRun *testRun)
+{
+    UNUSED(suite);
+    StartReport *startReport = state;
+    if (reportEvent == TEST_RUN_FINISHED && strcmp(testRun->test->name, "long") == 0)
+    {
+        startReport->longStart = testRun->startTime;
+    }
+    else if (reportEvent == TEST_RUN_FINISHED && strcmp(testRun->test->name, "short2") == 0)
+    {
+        startReport->short2Start = testRun->startTime;
+    }
+}
+
+static void write_durations(const char *path)
+{
+    write_file(path, "ForSchedule.short1\t0.010000\nForSchedule.short2\t0.010000\nForSchedule.long\t1.000000\n"
+                     "Removed.test\t5.000000\n");
+}
+
+void test_run_longest_first(YacuTestRun *testRun)
+{
+    write_durations("schedule.cache");
+    const char *argv[] = {"./tests", "--jobs", "2", "--cache", "schedule.cache"};
+    StartReport startState = {0.0, 0.0};
+    YacuReport startReport = {&startState, start_report_action};
+    YacuOptions options = yacu_default_options();
+    yacu_apply_cmd_args(&options, 5, argv);
+    options.customReport = &startReport;
+    YacuStatus returnCode = yacu_execute(options, suites4Schedule);
+    YACU_ASSERT_EQ_INT(testRun, returnCode, OK);
+    YACU_ASSERT_TRUE(testRun, startState.longStart < startState.short2Start);
+    char content[1024];
+    read_file("schedule.cache", content, sizeof(content));
+    YACU_ASSERT_IN_STR(testRun, "Removed.test\t5.000000\t0\n", content);
+    YACU_ASSERT_TRUE(testRun, strstr(content, "ForSchedule.long\t1.000000\t") == NULL);
+    remove("schedule.cache");
+}
+
+void test_run_balanced_shards(YacuTestRun *testRun)
+{
+    write_durations("durations.cache");
+    OrderReport orderState = {""};
+    YacuReport orderReport = {&orderState, order_report_action};
+    const char *firstArgv[] = {"./tests", "--shard", "1/2", "--shard-durations", "durations.cache"};
+    YacuOptions options = yacu_default_options();
+    yacu_apply_cmd_args(&options, 5, firstArgv);
+    options.customReport = &orderReport;
+    yacu_execute(options, suites4Schedule);
+    YACU_ASSERT_EQ_STR(testRun, orderState.order, "[ForSchedule long:0]");
+    const char *secondArgv[] = {"./tests", "--shard", "2/2", "--shard-durations", "durations.cache"};
+    orderState.order[0] = '\0';
+    yacu_apply_cmd_args(&options, 5, secondArgv);
+    yacu_execute(options, suites4Schedule);
+    YACU_ASSERT_EQ_STR(testRun, orderState.order, "[ForSchedule short1:0 short2:0]");
+    remove("durations.cache");
+}
+
+void test_run_case_durations(YacuTestRun *testRun)
+{
+    write_file("cases.cache", "ForCaseSchedule.long\t1.000000\nForCaseSchedule.param/0\t0.500000\nForCaseSchedule.param/1\t0.600000\n"
+                              "ForCaseSchedule.short1\t0.010000\nForCaseSchedule.short2\t0.010000\n");
+    OrderReport orderState = {""};
+    YacuReport orderReport = {&orderState, order_report_action};
+    const char *argv[] = {"./tests", "--shard", "1/2", "--shard-durations", "cases.cache"};
+    YacuOptions options = yacu_default_options();
+    yacu_apply_cmd_args(&options, 5, argv);
+    options.customReport = &orderReport;
+    yacu_execute(options, suites4CaseSchedule);
+    YACU_ASSERT_EQ_STR(testRun, orderState.order, "[ForCaseSchedule param:0 param:0]");
+    remove("cases.cache");
+}
+
+void test_run_case_shards(YacuTestRun *testRun)
+{
+    OrderReport orderState = {""};
+    YacuReport orderReport = {&orderState, order_report_action};
+    const char *firstArgv[] = {"./tests", "--shard", "1/2"};
+    YacuOptions options = yacu_default_options();
+    yacu_apply_cmd_args(&options, 3, firstArgv);
+    options.customReport = &orderReport;
+    yacu_execute(options, suites4CaseSchedule);
+    YACU_ASSERT_EQ_STR(testRun, orderState.order, "[ForCaseSchedule param:0 param:0 short2:0]");
+    const char *secondArgv[] = {"./tests", "--shard", "2/2"};
+    orderState.order[0] = '\0';
+    yacu_apply_cmd_args(&options, 3, secondArgv);
+    yacu_execute(options, suites4CaseSchedule);
+    YACU_ASSERT_EQ_STR(testRun, orderState.order, "[ForCaseSchedule long:0 short1:0]");
+}
+
+void test_run_previous_failures(YacuTestRun *testRun)
+{
+    remove("results.cache");
+    const char *firstArgv[] = {"./tests", "--cache", "results.cache"};
+    run_selection(testRun, 3, firstArgv, "[ForOthers simpleEqInt:0][ForParallel first:0 failing:1 third:0 fourth:0]");
+    const char *lastFailedArgv[] = {"./tests", "--cache", "results.cache", "--last-failed"};
+    run_selection(testRun, 4, lastFailedArgv, "[ForParallel failing:1]");
+    const char *failedFirstArgv[] = {"./tests", "--cache", "results.cache", "--failed-first", "--jobs", "2"};
+    run_selection(testRun, 6, failedFirstArgv,
+                  "[ForParallel failing:1][ForOthers simpleEqInt:0][ForParallel first:0 third:0 fourth:0]");
+    char content[1024];
+    read_file("results.cache", content, sizeof(content));
+    YACU_ASSERT_IN_STR(testRun, "ForParallel.failing\t", content);
+    YACU_ASSERT_IN_STR(testRun, "\t1\nForParallel.third\t", content);
+    const char *unselectedArgv[] = {"./tests", "--cache", "results.cache", "--last-failed", "--filter", "-*.failing"};
+    run_selection(testRun, 6, unselectedArgv, "[ForOthers simpleEqInt:0][ForParallel first:0 third:0 fourth:0]");
+    remove("results.cache");
+}
+
+void test_run_last_failed_without_failures(YacuTestRun *testRun)
+{
+    remove("passed.cache");
+    const char *firstArgv[] = {"./tests", "--cache", "passed.cache", "--filter", "-*.failing"};
+    run_selection(testRun, 5, firstArgv, "[ForOthers simpleEqInt:0][ForParallel first:0 third:0 fourth:0]");
+    const char *lastFailedArgv[] = {"./tests", "--cache", "passed.cache", "--last-failed"};
+    run_selection(testRun, 4, lastFailedArgv, "[ForOthers simpleEqInt:0][ForParallel first:0 failing:1 third:0 fourth:0]");
+    remove("passed.cache");
+}
+
+void test_last_failed_without_cache(YacuTestRun *testRun)
+{
+    YacuProcessHandle pid = yacu_fork();
+    if (yacu_is_forked(pid))
+    {
+        const char *argv[] = {"./tests", "--last-failed"};
+        YacuOptions options = yacu_default_options();
+        yacu_apply_cmd_args(&options, 2, argv);
+        UNUSED(options);
+    }
+    else
+    {
+        YacuStatus returnCode = yacu_wait_for_forked(pid);
+        YACU_ASSERT_EQ_INT(testRun, returnCode, WRONG_ARGS);
+    }
+}
+
+void test_run_without_cache(YacuTestRun *testRun)
+{
+    remove(".yacucache");
+    const char *argv[] = {"./tests"};
+    run_selection(testRun, 1, argv, "[ForOthers simpleEqInt:0][ForParallel first:0 failing:1 third:0 fourth:0]");
+    FILE *file = fopen(".yacucache", "r");
+    YACU_ASSERT_TRUE(testRun, file == NULL);
+    if (file != NULL)
+    {
+        fclose(file);
+    }
+    remove("dropped.cache");
+    const char *droppedArgv[] = {"./tests", "--cache", "dropped.cache", "--no-cache"};
+    run_selection(testRun, 4, droppedArgv, "[ForOthers simpleEqInt:0][ForParallel first:0 failing:1 third:0 fourth:0]");
+    file = fopen("dropped.cache", "r");
+    YACU_ASSERT_TRUE(testRun, file == NULL);
+    if (file != NULL)
+    {
+        fclose(file);
+    }
+}
+
+void test_wrong_shard_args(YacuTestRun *testRun)
+{
+    YacuProcessHandle pid = yacu_fork();
+    if (yacu_is_forked(pid))
+    {
+        const char *argv[] = {"./tests", "--shard", "3/2"};
+        YacuOptions options = yacu_default_options();
+        yacu_apply_cmd_args(&options, 3, argv);
+        UNUSED(options);
+    }
+    else
+    {
+        YacuStatus returnCode = yacu_wait_for_forked(pid);
+        YACU_ASSERT_EQ_INT(testRun, returnCode, WRONG_ARGS);
+    }
+}
+
+void test_touch_memory(YacuTestRun *testRun)
+{
+    size_t size = 16 << 20;
+    char *volatile memory = malloc(size);
+    YACU_ASSERT_TRUE(testRun, memory != NULL);
+    memset(memory, 1, size);
+    free(memory);
+}
+
+YacuTest forUsage[] = {
+    {.name = "small", .fcn = &test_simple_eq_int},
+    {.name = "large", .fcn = &test_touch_memory},
+    END_OF_TESTS};
+
+YacuSuite suites4Usage[] = {
+    {.name = "ForUsage", .tests = forUsage},
+    END_OF_SUITES};
+
+typedef struct UsageReport
+{
+    YacuResourceUsage small;
+    YacuResourceUsage large;
+} UsageReport;
+
+static void usage_report_action(YacuReportState state, YacuReportEvent reportEvent, const YacuSuite *suite, const YacuTestRun *testRun)
+{
+    UNUSED(suite);
+    UsageReport *usageReport = state;
+    if (reportEvent == TEST_RUN_FINISHED)
+    {
+        *(strcmp(testRun->test->name, "small") == 0 ? &usageReport->small : &usageReport->large) = testRun->usage;
+    }
+}
+
+void test_run_resource_usage(YacuTestRun *testRun)
+{
+    const char *argv[] = {"./tests", "--isolated", "--junit", "usage.xml"};
+    UsageReport usageState;
+    memset(&usageState, 0, sizeof(usageState));
+    YacuReport usageReport = {&usageState, usage_report_action};
+    YacuOptions options = yacu_default_options();
+    yacu_apply_cmd_args(&options, 4, argv);
+    options.customReport = &usageReport;
+    YacuStatus returnCode = yacu_execute(options, suites4Usage);
+    YACU_ASSERT_EQ_INT(testRun, returnCode, OK);
+    YACU_ASSERT_TRUE(testRun, usageState.small.maxRssKb > 0);
+    YACU_ASSERT_TRUE(testRun, usageState.large.maxRssKb >= usageState.small.maxRssKb + 8192);
+    YACU_ASSERT_TRUE(testRun, usageState.large.minorFaults > usageState.small.minorFaults);
+    char content[16384];
+    read_file("usage.xml", content, sizeof(content));
+    YACU_ASSERT_IN_STR(testRun, "<property name=\"usage.max_rss_kb\" value=\"", content);
+    YACU_ASSERT_IN_STR(testRun, "<property name=\"usage.involuntary_switches\" value=\"", content);
+    remove("usage.xml");
+}
+
+typedef struct ThreadReport
+{
+    pthread_t caller;
+    size_t events;
+    size_t offThread;
+    size_t finished;
+} ThreadReport;
+
+static void thread_report_action(YacuReportState state, YacuReportEvent reportEvent, const YacuSuite *suite, const YacuTestRun *testRun)
+{
+    UNUSED(suite);
+    ThreadReport *threadReport = state;
+    threadReport->events++;
+    threadReport->offThread += pthread_equal(pthread_self(), threadReport->caller) ? 0 : 1;
+    if (reportEvent == TEST_RUN_FINISHED && testRun->result == OK)
+    {
+        threadReport->finished++;
+    }
+}
+
+void test_run_async_reports(YacuTestRun *testRun)
+{
+    const char *argv[] = {"./tests", "--async-reports"};
+    OrderReport orderState = {""};
+    YacuReport orderReport = {&orderState, order_report_action};
+    YacuOptions options = yacu_default_options();
+    yacu_apply_cmd_args(&options, 2, argv);
+    options.stdoutReport = false;
+    options.customReport = &orderReport;
+    YacuStatus returnCode = yacu_execute(options, suites4Parallel);
+    YACU_ASSERT_EQ_INT(testRun, returnCode, TEST_FAILURE);
+    YACU_ASSERT_EQ_STR(testRun, orderState.order,
+                       "[ForOthers simpleEqInt:0][ForParallel first:0 failing:1 third:0 fourth:0]");
+
+    // More events than the ring holds, so the producer has to wait for it.
+    size_t testCount = 2 * YACU_REPORT_QUEUE_SIZE;
+    YacuTest *manyTests = calloc(testCount + 1, sizeof(YacuTest));
+    YACU_ASSERT_TRUE(testRun, manyTests != NULL);
+    for (size_t i = 0; i < testCount; i++)
+    {
+        manyTests[i].name = "simpleEqInt";
+        manyTests[i].fcn = &test_simple_eq_int;
+    }
+    YacuSuite manySuites[] = {{.name = "ForAsync", .tests = manyTests}, END_OF_SUITES};
+    ThreadReport threadState = {pthread_self(), 0, 0, 0};
+    YacuReport threadReport = {&threadState, thread_report_action};
+    const char *jobsArgv[] = {"./tests", "--async-reports", "--jobs", "2"};
+    for (int argc = 2; argc <= 4; argc += 2)
+    {
+        threadState.events = 0;
+        threadState.offThread = 0;
+        threadState.finished = 0;
+        options = yacu_default_options();
+        yacu_apply_cmd_args(&options, argc, jobsArgv);
+        options.stdoutReport = false;
+        options.customReport = &threadReport;
+        returnCode = yacu_execute(options, manySuites);
+        YACU_ASSERT_EQ_INT(testRun, returnCode, OK);
+        YACU_ASSERT_EQ_UINT(testRun, (unsigned)threadState.finished, (unsigned)testCount);
+        YACU_ASSERT_EQ_UINT(testRun, (unsigned)threadState.events, (unsigned)(2 * testCount + 3));
+        YACU_ASSERT_EQ_UINT(testRun, (unsigned)threadState.offThread, (unsigned)threadState.events);
+    }
+    free(manyTests);
+}
+
+static void convert_log(const char *logPath, YacuLogFormat format, const char *statusFilter, char *content, size_t size)
+{
+    FILE *output = fopen("converted.txt", "w");
+    if (output != NULL)
+    {
+        yacu_convert_log(logPath, format, statusFilter, output);
+        fclose(output);
+    }
+    read_file("converted.txt", content, size);
+}
+
+void test_run_binary_log(YacuTestRun *testRun)
+{
+    const char *argv[] = {"./tests", "--binary-log", "results.yacu", "--jobs", "2"};
+    YacuOptions options = yacu_default_options();
+    yacu_apply_cmd_args(&options, 5, argv);
+    options.stdoutReport = false;
+    YacuStatus returnCode = yacu_execute(options, suites4Parallel);
+    YACU_ASSERT_EQ_INT(testRun, returnCode, TEST_FAILURE);
+    char content[16384];
+    convert_log("results.yacu", LOG_JSON_LINES, NULL, content, sizeof(content));
+    YACU_ASSERT_IN_STR(testRun, "{\"suite\":\"ForOthers\",\"test\":\"simpleEqInt\",\"status\":\"OK\",", content);
+    YACU_ASSERT_IN_STR(testRun, "\"test\":\"fourth\",\"status\":\"OK\",", content);
+    convert_log("results.yacu", LOG_JSON_LINES, "FAILURE", content, sizeof(content));
+    YACU_ASSERT_IN_STR(testRun, "\"test\":\"failing\",\"status\":\"FAILURE\",", content);
+    YACU_ASSERT_IN_STR(testRun, "Assertion x == 2 (1 == 2) failed!\"}\n", content);
+    YACU_ASSERT_TRUE(testRun, strstr(content, "\"OK\"") == NULL);
+    convert_log("results.yacu", LOG_JUNIT, NULL, content, sizeof(content));
+    YACU_ASSERT_IN_STR(testRun, "<testsuite name=\"ForParallel\" tests=\"4\" failures=\"1\" errors=\"0\" time=\"", content);
+    YACU_ASSERT_IN_STR(testRun, "<failure type=\"FAILURE\" message=\"", content);
+    convert_log("results.yacu", LOG_SUMMARY, NULL, content, sizeof(content));
+    YACU_ASSERT_IN_STR(testRun, "Tests: 5\n  OK: 4\n  FAILURE: 1\n", content);
+
+    // A message that lost its terminator is still printed by its length.
+    char logData[16384];
+    FILE *log = fopen("results.yacu", "r+b");
+    YACU_ASSERT_TRUE(testRun, log != NULL);
+    size_t logSize = fread(logData, 1, sizeof(logData), log);
+    const char *failed = "(1 == 2) failed!";
+    for (size_t i = 0; i + strlen(failed) <= logSize; i++)
+    {
+        if (memcmp(logData + i, failed, strlen(failed)) == 0)
+        {
+            size_t end = i + strlen(failed);
+            fseek(log, (long)end, SEEK_SET);
+            fwrite("XXXXXXXX", 1, 8 - end % 8, log);
+            break;
+        }
+    }
+    fclose(log);
+    convert_log("results.yacu", LOG_JSON_LINES, "FAILURE", content, sizeof(content));
+    YACU_ASSERT_IN_STR(testRun, "Assertion x == 2 (1 == 2) failed!\"}\n", content);
+
+    // A run that died midway leaves a truncated record that is skipped.
+    log = fopen("results.yacu", "r+b");
+    YACU_ASSERT_TRUE(testRun, log != NULL);
+    fseek(log, 0, SEEK_END);
+    long size = ftell(log);
+    fclose(log);
+    YACU_ASSERT_EQ_INT(testRun, truncate("results.yacu", size - 8), 0);
+    convert_log("results.yacu", LOG_SUMMARY, NULL, content, sizeof(content));
+    YACU_ASSERT_IN_STR(testRun, "Tests: 4\n", content);
+    YACU_ASSERT_EQ_INT(testRun, yacu_convert_log("results.yacu", LOG_SUMMARY, "PASSED", stdout), WRONG_ARGS);
+    YACU_ASSERT_EQ_INT(testRun, yacu_convert_log("converted.txt", LOG_SUMMARY, NULL, stdout), FILE_FAIL);
+    remove("converted.txt");
+    remove("results.yacu");
+}
+
+typedef struct SharedFixture
+{
+    YacuProcessHandle pid;
+    int uses;
+} SharedFixture;
+
+static int suiteSetups = 0;
+static int suiteTeardowns = 0;
+static int testSetups = 0;
+static int testTeardowns = 0;
+
+static void setup_shared_fixture(YacuTestRun *testRun)
+{
+    SharedFixture *fixture = malloc(sizeof(SharedFixture));
+    YACU_ASSERT_TRUE(testRun, fixture != NULL);
+    fixture->pid = getpid();
+    fixture->uses = 0;
+    testRun->fixture = fixture;
+    suiteSetups++;
+}
+
+static void teardown_shared_fixture(YacuTestRun *testRun)
+{
+    free(testRun->fixture);
+    suiteTeardowns++;
+}
+
+static void setup_test_fixture(YacuTestRun *testRun)
+{
+    testRun->testFixture = &((SharedFixture *)testRun->fixture)->uses;
+    testSetups++;
+}
+
+static void teardown_test_fixture(YacuTestRun *testRun)
+{
+    YACU_ASSERT_TRUE(testRun, testRun->testFixture != NULL);
+    testTeardowns++;
+}
+
+void test_use_fixture(YacuTestRun *testRun)
+{
+    SharedFixture *fixture = testRun->fixture;
+    YACU_ASSERT_TRUE(testRun, fixture != NULL);
+    // Isolated tests inherit the fixture from the process that forked them.
+    YACU_ASSERT_TRUE(testRun, fixture->pid == getpid() || fixture->pid == getppid());
+    int *uses = testRun->testFixture;
+    (*uses)++;
+    test_run_message_append(testRun, "%d", *uses);
+}
+
+static void failing_setup(YacuTestRun *testRun)
+{
+    YACU_ASSERT_TRUE(testRun, testRun->fixture != NULL);
+}
+
+YacuTest forFixtures[] = {
+    {.name = "first", .fcn = &test_use_fixture, .setup = &setup_test_fixture, .teardown = &teardown_test_fixture},
+    {.name = "second", .fcn = &test_use_fixture, .setup = &setup_test_fixture, .teardown = &teardown_test_fixture},
+    {.name = "third", .fcn = &test_use_fixture, .setup = &setup_test_fixture, .teardown = &teardown_test_fixture},
+    {.name = "fourth", .fcn = &test_use_fixture, .setup = &setup_test_fixture, .teardown = &teardown_test_fixture},
+    END_OF_TESTS};
+
+YacuSuite suites4Fixtures[] = {
+    {.name = "ForFixtures", .tests = forFixtures, .setup = &setup_shared_fixture, .teardown = &teardown_shared_fixture},
+    {.name = "ForOthers", .tests = forOthers},
+    {.name = "ForFailingFixture", .tests = forOthers, .setup = &failing_setup, .teardown = &teardown_shared_fixture},
+    END_OF_SUITES};
+
+typedef struct FixtureReport
+{
+    int firstUses;
+    int ok;
+    int failures;
+} FixtureReport;
+
+static void fixture_report_action(YacuReportState state, YacuReportEvent reportEvent, const YacuSuite *suite, const YacuTestRun *testRun)
+{
+    FixtureReport *fixtureReport = state;
+    if (reportEvent != TEST_RUN_FINISHED)
+    {
+        return;
+    }
+    if (strcmp(suite->name, "ForFailingFixture") == 0)
+    {
+        fixtureReport->failures += testRun->result == TEST_FAILURE && strstr(testRun->message, "Assertion testRun->fixture != ") != NULL;
+    }
+    else if (strcmp(suite->name, "ForFixtures") == 0 && testRun->result == OK)
+    {
+        fixtureReport->ok++;
+        fixtureReport->firstUses += strcmp(testRun->message, "1") == 0;
+    }
+}
+
+void test_run_fixtures(YacuTestRun *testRun)
+{
+    const char *argv[] = {"./tests", "--jobs", "2"};
+    for (int argc = 1; argc <= 3; argc += 2)
+    {
+        FixtureReport fixtureState = {0, 0, 0};
+        YacuReport fixtureReport = {&fixtureState, fixture_report_action};
+        suiteTeardowns = 0;
+        testSetups = 0;
+        testTeardowns = 0;
+        YacuOptions options = yacu_default_options();
+        yacu_apply_cmd_args(&options, argc, argv);
+        options.stdoutReport = false;
+        options.customReport = &fixtureReport;
+        YacuStatus returnCode = yacu_execute(options, suites4Fixtures);
+        YACU_ASSERT_EQ_INT(testRun, returnCode, TEST_FAILURE);
+        YACU_ASSERT_EQ_INT(testRun, fixtureState.ok, 4);
+        YACU_ASSERT_EQ_INT(testRun, fixtureState.failures, 1);
+        YACU_ASSERT_TRUE(testRun, fixtureState.firstUses >= 1 && fixtureState.firstUses <= (argc + 1) / 2);
+        if (argc == 1)
+        {
+            YACU_ASSERT_EQ_INT(testRun, suiteTeardowns, 1);
+            YACU_ASSERT_EQ_INT(testRun, testSetups, 4);
+            YACU_ASSERT_EQ_INT(testRun, testTeardowns, 4);
+        }
+    }
+    FixtureReport isolatedState = {0, 0, 0};
+    YacuReport isolatedReport = {&isolatedState, fixture_report_action};
+    suiteSetups = 0;
+    suiteTeardowns = 0;
+    const char *isolatedArgv[] = {"./tests", "--isolated", "--jobs", "2"};
+    YacuOptions options = yacu_default_options();
+    yacu_apply_cmd_args(&options, 4, isolatedArgv);
+    options.stdoutReport = false;
+    options.customReport = &isolatedReport;
+    YacuStatus returnCode = yacu_execute(options, suites4Fixtures);
+    YACU_ASSERT_EQ_INT(testRun, returnCode, TEST_FAILURE);
+    YACU_ASSERT_EQ_INT(testRun, isolatedState.ok, 4);
+    YACU_ASSERT_EQ_INT(testRun, isolatedState.failures, 1);
+    YACU_ASSERT_EQ_INT(testRun, isolatedState.firstUses, 4);
+    YACU_ASSERT_EQ_INT(testRun, suiteSetups, 1);
+    YACU_ASSERT_EQ_INT(testRun, suiteTeardowns, 1);
+}
+
+void test_wrong_jobs_args(YacuTestRun *testRun)
+{
+    YacuProcessHandle pid = yacu_fork();
+    if (yacu_is_forked(pid))
+    {
+        const char *argv[] = {"./tests", "--jobs", "many"};
+        YacuOptions options = yacu_default_options();
+        yacu_apply_cmd_args(&options, 3, argv);
+        UNUSED(options);
+    }
+    else
+    {
+        YacuStatus returnCode = yacu_wait_for_forked(pid);
+        YACU_ASSERT_EQ_INT(testRun, returnCode, WRONG_ARGS);
+    }
+}
+
 YacuTest otherTests[] = {
-    {"SingleTestTest", &test_run_single_test},
-    {"SingleSuiteTest", &test_run_single_suite},
-    {"SingleSuiteTestWithFork", &test_run_single_suite_with_fork},
-    {"WrongArgsTest", &test_wrong_args},
-    {"MissingTestArgs", &test_missing_test_args},
-    {"MissingJUnitArgs", &test_missing_junit_args},
-    {"JUnitCreationFailTest", &test_junit_creation_fail},
-    {"JUnitCreationTest", &test_junit_creation},
+    {.name = "SingleTestTest", .fcn = &test_run_single_test},
+    {.name = "SingleSuiteTest", .fcn = &test_run_single_suite},
+    {.name = "SingleSuiteTestWithFork", .fcn = &test_run_single_suite_with_fork},
+    {.name = "WrongArgsTest", .fcn = &test_wrong_args},
+    {.name = "MissingTestArgs", .fcn = &test_missing_test_args},
+    {.name = "MissingJUnitArgs", .fcn = &test_missing_junit_args},
+    {.name = "JUnitCreationFailTest", .fcn = &test_junit_creation_fail},
+    {.name = "JUnitCreationTest", .fcn = &test_junit_creation},
+    {.name = "ParallelTest", .fcn = &test_run_parallel},
+    {.name = "SerialAbortTest", .fcn = &test_run_serial_abort},
+    {.name = "IsolatedTest", .fcn = &test_run_isolated},
+    {.name = "ForkServerTest", .fcn = &test_run_fork_server},
+    {.name = "TimingTest", .fcn = &test_run_timed},
+    {.name = "JUnitCountsTest", .fcn = &test_junit_counts},
+    {.name = "JUnitPartialTest", .fcn = &test_junit_partial},
+    {.name = "MessageLengthsTest", .fcn = &test_run_message_lengths},
+    {.name = "ResourceUsageTest", .fcn = &test_run_resource_usage},
+    {.name = "TimeoutTest", .fcn = &test_run_timeout},
+    {.name = "TimeoutOverrideTest", .fcn = &test_run_timeout_override},
+    {.name = "ShardTest", .fcn = &test_run_shards},
+    {.name = "WrongShardArgs", .fcn = &test_wrong_shard_args},
+    {.name = "LongestFirstTest", .fcn = &test_run_longest_first},
+    {.name = "BalancedShardTest", .fcn = &test_run_balanced_shards},
+    {.name = "CaseDurationsTest", .fcn = &test_run_case_durations},
+    {.name = "CaseShardTest", .fcn = &test_run_case_shards},
+    {.name = "PreviousFailuresTest", .fcn = &test_run_previous_failures},
+    {.name = "LastFailedWithoutFailuresTest", .fcn = &test_run_last_failed_without_failures},
+    {.name = "LastFailedWithoutCache", .fcn = &test_last_failed_without_cache},
+    {.name = "NoCacheByDefaultTest", .fcn = &test_run_without_cache},
+    {.name = "FilterTest", .fcn = &test_run_filters},
+    {.name = "FilterFileTest", .fcn = &test_run_filter_file},
+    {.name = "MissingFilterFile", .fcn = &test_missing_filter_file},
+    {.name = "AsyncReportsTest", .fcn = &test_run_async_reports},
+    {.name = "BinaryLogTest", .fcn = &test_run_binary_log},
+    {.name = "FixturesTest", .fcn = &test_run_fixtures},
+    {.name = "WrongJobsArgs", .fcn = &test_wrong_jobs_args},
     END_OF_TESTS};
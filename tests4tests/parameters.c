@@ -0,0 +1,389 @@
+#include <yacu.h>
+#include <parameters.h>
+#include <support.h>
+
+#include <signal.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define UNUSED(x) (void)(x)
+
+typedef struct SumCase
+{
+    int left;
+    int right;
+    int sum;
+} SumCase;
+
+static const SumCase sumCases[] = {
+    {1, 2, 3},
+    {-4, 4, 0},
+    {2, 2, 5},
+    {100, 23, 123},
+};
+
+void test_sum_case(YacuTestRun *testRun)
+{
+    const SumCase *sumCase = testRun->testCase;
+    YACU_ASSERT_EQ_INT(testRun, sumCase->left + sumCase->right, sumCase->sum);
+}
+
+static void generate_double(size_t index, void *testCase, const void *runData)
+{
+    UNUSED(runData);
+    *(size_t *)testCase = 2 * index;
+}
+
+void test_generated_case(YacuTestRun *testRun)
+{
+    YACU_ASSERT_EQ_UINT(testRun, (unsigned)*(const size_t *)testRun->testCase, (unsigned)(2 * testRun->caseIndex));
+}
+
+void test_crashing_case(YacuTestRun *testRun)
+{
+    if (testRun->caseIndex == 5)
+    {
+        raise(SIGTERM);
+    }
+}
+
+void test_bounded_int(YacuTestRun *testRun)
+{
+    int64_t value = yacu_draw_int(testRun, -1000000, 1000000);
+    YACU_ASSERT_TRUE(testRun, value > -1000 && value < 1000);
+}
+
+void test_string_without_x(YacuTestRun *testRun)
+{
+    char text[33];
+    yacu_draw_string(testRun, text, 32, NULL);
+    YACU_ASSERT_TRUE(testRun, strchr(text, 'x') == NULL);
+}
+
+void test_reversed_bytes(YacuTestRun *testRun)
+{
+    uint8_t bytes[64];
+    uint8_t reversed[64];
+    size_t size = yacu_draw_bytes(testRun, bytes, sizeof(bytes));
+    for (size_t i = 0; i < size; i++)
+    {
+        reversed[size - 1 - i] = bytes[i];
+    }
+    for (size_t i = 0; i < size; i++)
+    {
+        YACU_ASSERT_EQ_UINT(testRun, reversed[size - 1 - i], bytes[i]);
+    }
+    double scale = yacu_draw_double(testRun, 0.5, 2.0);
+    YACU_ASSERT_TRUE(testRun, scale >= 0.5 && scale <= 2.0);
+}
+
+int fuzz_parse(const uint8_t *data, size_t size)
+{
+    if (size >= 4 && memcmp(data, "hang", 4) == 0)
+    {
+        for (;;)
+        {
+        }
+    }
+    if (size >= 5 && memcmp(data, "crash", 5) == 0)
+    {
+        raise(SIGABRT);
+    }
+    return size >= 3 && memcmp(data, "bad", 3) == 0 ? 1 : 0;
+}
+
+YacuTest forFuzzing[] = {
+    YACU_FUZZ_TEST("parse", &fuzz_parse),
+    END_OF_TESTS};
+
+YacuSuite suites4Fuzzing[] = {
+    {.name = "ForFuzzing", .tests = forFuzzing},
+    END_OF_SUITES};
+
+YacuTest forProperties[] = {
+    YACU_PROPERTY_TEST("boundedInt", &test_bounded_int, 2500),
+    YACU_PROPERTY_TEST("stringWithoutX", &test_string_without_x, 100),
+    YACU_PROPERTY_TEST("reversedBytes", &test_reversed_bytes, 3000),
+    {.name = "drawOutside", .fcn = &test_bounded_int},
+    END_OF_TESTS};
+
+YacuTest forParameters[] = {
+    {.name = "sum", .fcn = &test_sum_case, YACU_CASES(sumCases)},
+    {.name = "generated", .fcn = &test_generated_case, .caseSize = sizeof(size_t), .caseCount = 1000, .generate = &generate_double},
+    {.name = "crashing", .fcn = &test_crashing_case, .caseCount = 150},
+    END_OF_TESTS};
+
+YacuSuite suites4Parameters[] = {
+    {.name = "ForParameters", .tests = forParameters},
+    END_OF_SUITES};
+
+YacuSuite suites4Properties[] = {
+    {.name = "ForProperties", .tests = forProperties},
+    END_OF_SUITES};
+
+typedef struct CaseReport
+{
+    size_t ok;
+    size_t lastIndex;
+    bool ordered;
+    char failures[256];
+    char names[256];
+} CaseReport;
+
+static void case_report_action(YacuReportState state, YacuReportEvent reportEvent, const YacuSuite *suite, const YacuTestRun *testRun)
+{
+    UNUSED(suite);
+    CaseReport *caseReport = state;
+    if (reportEvent != TEST_RUN_FINISHED)
+    {
+        return;
+    }
+    if (strcmp(testRun->test->name, "sum") == 0)
+    {
+        size_t length = strlen(caseReport->names);
+        const SumCase *sumCase = testRun->testCase;
+        snprintf(caseReport->names + length, sizeof(caseReport->names) - length, " %zu:%d", testRun->caseIndex, sumCase->sum);
+    }
+    if (testRun->result == OK)
+    {
+        caseReport->ok++;
+    }
+    else
+    {
+        size_t length = strlen(caseReport->failures);
+        snprintf(caseReport->failures + length, sizeof(caseReport->failures) - length, " %s/%zu:%d",
+                 testRun->test->name, testRun->caseIndex, testRun->result);
+    }
+    caseReport->ordered = caseReport->ordered && (testRun->caseIndex == 0 || testRun->caseIndex == caseReport->lastIndex + 1);
+    caseReport->lastIndex = testRun->caseIndex;
+}
+
+void test_run_parameterized(YacuTestRun *testRun)
+{
+    const char *argv[] = {"./tests", "--filter", "-*.crashing"};
+    CaseReport caseState = {0, 0, true, "", ""};
+    YacuReport caseReport = {&caseState, case_report_action};
+    YacuOptions options = yacu_default_options();
+    yacu_apply_cmd_args(&options, 3, argv);
+    options.stdoutReport = false;
+    options.customReport = &caseReport;
+    YacuStatus returnCode = yacu_execute(options, suites4Parameters);
+    YACU_ASSERT_EQ_INT(testRun, returnCode, TEST_FAILURE);
+    YACU_ASSERT_EQ_STR(testRun, caseState.names, " 0:3 1:0 2:5 3:123");
+    YACU_ASSERT_EQ_STR(testRun, caseState.failures, " sum/2:1");
+    YACU_ASSERT_EQ_UINT(testRun, (unsigned)caseState.ok, 1003u);
+    YACU_ASSERT_TRUE(testRun, caseState.ordered);
+}
+
+void test_chunk_parameterized(YacuTestRun *testRun)
+{
+    const char *argv[] = {"./tests", "--jobs", "3", "--junit", "parameters.xml"};
+    CaseReport caseState = {0, 0, true, "", ""};
+    YacuReport caseReport = {&caseState, case_report_action};
+    YacuOptions options = yacu_default_options();
+    yacu_apply_cmd_args(&options, 5, argv);
+    options.stdoutReport = false;
+    options.customReport = &caseReport;
+    YacuStatus returnCode = yacu_execute(options, suites4Parameters);
+    YACU_ASSERT_EQ_INT(testRun, returnCode, TEST_FAILURE);
+    YACU_ASSERT_EQ_STR(testRun, caseState.names, " 0:3 1:0 2:5 3:123");
+    YACU_ASSERT_IN_STR(testRun, " sum/2:1", caseState.failures);
+    YACU_ASSERT_IN_STR(testRun, " crashing/5:5", caseState.failures);
+    YACU_ASSERT_EQ_UINT(testRun, (unsigned)caseState.ok, 1152u);
+    char content[4096];
+    read_file("parameters.xml", content, sizeof(content));
+    YACU_ASSERT_IN_STR(testRun, " tests=\"1154\" failures=\"1\" errors=\"1\" time=\"", content);
+    YACU_ASSERT_IN_STR(testRun, "classname=\"ForParameters\" name=\"sum/2\" time=\"", content);
+    remove("parameters.xml");
+}
+
+void test_filter_parameterized(YacuTestRun *testRun)
+{
+    const char *argv[] = {"./tests", "--test", "ForParameters", "sum"};
+    CaseReport caseState = {0, 0, true, "", ""};
+    YacuReport caseReport = {&caseState, case_report_action};
+    YacuOptions options = yacu_default_options();
+    yacu_apply_cmd_args(&options, 4, argv);
+    options.stdoutReport = false;
+    options.customReport = &caseReport;
+    YacuStatus returnCode = yacu_execute(options, suites4Parameters);
+    YACU_ASSERT_EQ_INT(testRun, returnCode, TEST_FAILURE);
+    YACU_ASSERT_EQ_STR(testRun, caseState.failures, " sum/2:1");
+    YACU_ASSERT_EQ_UINT(testRun, (unsigned)caseState.ok, 3u);
+}
+
+typedef struct PropertyReport
+{
+    size_t ok;
+    char failures[1024];
+} PropertyReport;
+
+static void property_report_action(YacuReportState state, YacuReportEvent reportEvent, const YacuSuite *suite, const YacuTestRun *testRun)
+{
+    UNUSED(suite);
+    PropertyReport *propertyReport = state;
+    if (reportEvent != TEST_RUN_FINISHED)
+    {
+        return;
+    }
+    if (testRun->result == OK)
+    {
+        propertyReport->ok++;
+        return;
+    }
+    const char *falsified = strstr(testRun->message, "Falsified");
+    size_t length = strlen(propertyReport->failures);
+    snprintf(propertyReport->failures + length, sizeof(propertyReport->failures) - length, "[%s/%zu %s]",
+             testRun->test->name, testRun->caseIndex, falsified != NULL ? falsified : testRun->message);
+}
+
+static PropertyReport run_properties(int argc, const char *argv[])
+{
+    PropertyReport propertyState = {0, ""};
+    YacuReport propertyReport = {&propertyState, property_report_action};
+    YacuOptions options = yacu_default_options();
+    yacu_apply_cmd_args(&options, argc, argv);
+    options.stdoutReport = false;
+    options.customReport = &propertyReport;
+    yacu_execute(options, suites4Properties);
+    return propertyState;
+}
+
+void test_shrink_properties(YacuTestRun *testRun)
+{
+    const char *argv[] = {"./tests", "--filter", "-*.drawOutside", "--seed", "7"};
+    PropertyReport serial = run_properties(5, argv);
+    YACU_ASSERT_IN_STR(testRun, "[boundedInt/0 Falsified by case ", serial.failures);
+    YACU_ASSERT_IN_STR(testRun, " after ", serial.failures);
+    YACU_ASSERT_IN_STR(testRun, " shrinks: 1000]", serial.failures);
+    YACU_ASSERT_IN_STR(testRun, " shrinks: \"x\"]", serial.failures);
+    YACU_ASSERT_EQ_UINT(testRun, (unsigned)serial.ok, 3u);
+    const char *parallelArgv[] = {"./tests", "--filter", "-*.drawOutside", "--seed", "7", "--jobs", "3"};
+    PropertyReport parallel = run_properties(7, parallelArgv);
+    YACU_ASSERT_EQ_STR(testRun, parallel.failures, serial.failures);
+    YACU_ASSERT_EQ_UINT(testRun, (unsigned)parallel.ok, 3u);
+}
+
+void test_full_range_seed(YacuTestRun *testRun)
+{
+    const char *argv[] = {"./tests", "--test", "ForProperties", "boundedInt", "--seed", "18446744073709551615"};
+    PropertyReport first = run_properties(6, argv);
+    YACU_ASSERT_IN_STR(testRun, " of --seed 18446744073709551615 after ", first.failures);
+    PropertyReport replayed = run_properties(6, argv);
+    YACU_ASSERT_EQ_STR(testRun, replayed.failures, first.failures);
+}
+
+void test_wrong_seed_args(YacuTestRun *testRun)
+{
+    const char *seeds[] = {"18446744073709551616", "-1", "7x"};
+    for (size_t i = 0; i < sizeof(seeds) / sizeof(seeds[0]); i++)
+    {
+        YacuProcessHandle pid = yacu_fork();
+        if (yacu_is_forked(pid))
+        {
+            const char *argv[] = {"./tests", "--seed", seeds[i]};
+            YacuOptions options = yacu_default_options();
+            yacu_apply_cmd_args(&options, 3, argv);
+            _exit(OK);
+        }
+        YacuStatus returnCode = yacu_wait_for_forked(pid);
+        YACU_ASSERT_EQ_INT(testRun, returnCode, WRONG_ARGS);
+    }
+}
+
+void test_property_options(YacuTestRun *testRun)
+{
+    const char *argv[] = {"./tests", "--test", "ForProperties", "reversedBytes", "--property-cases", "4500", "--jobs", "2"};
+    PropertyReport reversed = run_properties(8, argv);
+    YACU_ASSERT_EQ_STR(testRun, reversed.failures, "");
+    YACU_ASSERT_EQ_UINT(testRun, (unsigned)reversed.ok, 5u);
+    const char *outsideArgv[] = {"./tests", "--test", "ForProperties", "drawOutside"};
+    PropertyReport outside = run_properties(4, outsideArgv);
+    YACU_ASSERT_EQ_STR(testRun, outside.failures, "[drawOutside/0 drawOutside - yacu_draw_* needs a property test]");
+}
+
+static const char *corpusInputs[][2] = {
+    {"corpus/a-ok", "fine"},
+    {"corpus/b-bad", "bad input"},
+    {"corpus/c-crash", "crash here"},
+    {"corpus/d-hang", "hang"},
+    {"corpus/e-empty", ""},
+    {"corpus/f&ok", "also fine"},
+    {"corpus/.hidden", "crash"}};
+
+#define CORPUS_INPUTS (sizeof(corpusInputs) / sizeof(corpusInputs[0]))
+
+void test_replay_corpus(YacuTestRun *testRun)
+{
+    mkdir("corpus", 0755);
+    for (size_t i = 0; i < CORPUS_INPUTS; i++)
+    {
+        write_file(corpusInputs[i][0], corpusInputs[i][1]);
+    }
+    const char *argv[] = {"./tests", "--corpus", "corpus", "--timeout", "0.2", "--junit", "corpus.xml", "--async-reports"};
+    PropertyReport corpusState = {0, ""};
+    YacuReport corpusReport = {&corpusState, property_report_action};
+    YacuOptions options = yacu_default_options();
+    yacu_apply_cmd_args(&options, 8, argv);
+    options.stdoutReport = false;
+    options.customReport = &corpusReport;
+    YacuStatus returnCode = yacu_execute(options, suites4Fuzzing);
+    YACU_ASSERT_EQ_INT(testRun, returnCode, TEST_FAILURE);
+    YACU_ASSERT_EQ_STR(testRun, corpusState.failures,
+                       "[parse/1 Fuzz target returned 1 on a 9 byte input]"
+                       "[parse/2 Test process killed by signal 6]"
+                       "[parse/3 Test timed out after 0.200 s]");
+    YACU_ASSERT_EQ_UINT(testRun, (unsigned)corpusState.ok, 3u);
+    char content[4096];
+    read_file("corpus.xml", content, sizeof(content));
+    YACU_ASSERT_IN_STR(testRun, " tests=\"6\" failures=\"1\" errors=\"2\" time=\"", content);
+    YACU_ASSERT_IN_STR(testRun, "classname=\"ForFuzzing\" name=\"parse/c-crash\" time=\"", content);
+    YACU_ASSERT_IN_STR(testRun, "classname=\"ForFuzzing\" name=\"parse/f&amp;ok\" time=\"", content);
+    for (size_t i = 0; i < CORPUS_INPUTS; i++)
+    {
+        remove(corpusInputs[i][0]);
+    }
+    rmdir("corpus");
+    remove("corpus.xml");
+    const char *emptyArgv[] = {"./tests"};
+    PropertyReport emptyState = {0, ""};
+    YacuReport emptyReport = {&emptyState, property_report_action};
+    options = yacu_default_options();
+    yacu_apply_cmd_args(&options, 1, emptyArgv);
+    options.stdoutReport = false;
+    options.customReport = &emptyReport;
+    returnCode = yacu_execute(options, suites4Fuzzing);
+    YACU_ASSERT_EQ_INT(testRun, returnCode, OK);
+    YACU_ASSERT_EQ_UINT(testRun, (unsigned)emptyState.ok, 1u);
+}
+
+void test_replay_empty_corpus(YacuTestRun *testRun)
+{
+    mkdir("empty-corpus", 0755);
+    write_file("empty-corpus/.hidden", "crash");
+    const char *argv[] = {"./tests", "--corpus", "empty-corpus"};
+    PropertyReport emptyState = {0, ""};
+    YacuReport emptyReport = {&emptyState, property_report_action};
+    YacuOptions options = yacu_default_options();
+    yacu_apply_cmd_args(&options, 3, argv);
+    options.stdoutReport = false;
+    options.customReport = &emptyReport;
+    YacuStatus returnCode = yacu_execute(options, suites4Fuzzing);
+    YACU_ASSERT_EQ_INT(testRun, returnCode, OK);
+    YACU_ASSERT_EQ_STR(testRun, emptyState.failures, "");
+    YACU_ASSERT_EQ_UINT(testRun, (unsigned)emptyState.ok, 1u);
+    remove("empty-corpus/.hidden");
+    rmdir("empty-corpus");
+}
+
+YacuTest parameterTests[] = {
+    {.name = "parameterizedTest", .fcn = &test_run_parameterized},
+    {.name = "chunkParameterizedTest", .fcn = &test_chunk_parameterized},
+    {.name = "filterParameterizedTest", .fcn = &test_filter_parameterized},
+    {.name = "shrinkPropertiesTest", .fcn = &test_shrink_properties},
+    {.name = "propertyOptionsTest", .fcn = &test_property_options},
+    {.name = "fullRangeSeedTest", .fcn = &test_full_range_seed},
+    {.name = "wrongSeedArgs", .fcn = &test_wrong_seed_args},
+    {.name = "replayCorpusTest", .fcn = &test_replay_corpus},
+    {.name = "replayEmptyCorpusTest", .fcn = &test_replay_empty_corpus},
+    END_OF_TESTS};
@@ -0,0 +1,8 @@
+#ifndef PARAMETERS_H
+#define PARAMETERS_H
+
+#include <yacu.h>
+
+extern YacuTest parameterTests[];
+
+#endif // PARAMETERS_H
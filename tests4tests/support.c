@@ -0,0 +1,24 @@
+#include <support.h>
+
+#include <stdio.h>
+
+void read_file(const char *path, char *content, size_t size)
+{
+    FILE *file = fopen(path, "r");
+    size_t length = file == NULL ? 0 : fread(content, 1, size - 1, file);
+    content[length] = '\0';
+    if (file != NULL)
+    {
+        fclose(file);
+    }
+}
+
+void write_file(const char *path, const char *content)
+{
+    FILE *file = fopen(path, "w");
+    if (file != NULL)
+    {
+        fputs(content, file);
+        fclose(file);
+    }
+}
@@ -0,0 +1,11 @@
+#ifndef SUPPORT_H
+#define SUPPORT_H
+
+#include <stddef.h>
+
+// Reads at most size - 1 bytes of path into content; a missing file reads
+// as an empty string.
+void read_file(const char *path, char *content, size_t size);
+void write_file(const char *path, const char *content);
+
+#endif // SUPPORT_H
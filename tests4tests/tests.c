@@ -1,13 +1,19 @@
 #include <yacu.h>
 
+#include <allocations.h>
 #include <assertions.h>
+#include <benchmarks.h>
 #include <failures.h>
 #include <others.h>
+#include <parameters.h>
 
 YacuSuite suites[] = {
-    {"Assertions", assertionTests},
-    {"AssertionFailures", assertionFailuresTests},
-    {"Others", otherTests},
+    {.name = "Assertions", .tests = assertionTests},
+    {.name = "AssertionFailures", .tests = assertionFailuresTests},
+    {.name = "Others", .tests = otherTests},
+    {.name = "Benchmarks", .tests = benchmarkTests},
+    {.name = "Allocations", .tests = allocationTests},
+    {.name = "Parameters", .tests = parameterTests},
     END_OF_SUITES};
 
 int main(int argc, char const *argv[])